@@ -281,6 +281,15 @@ def addCommonOptions(parser):
         choices=ObjectList.indirect_bp_list.get_names(),
         help="type of indirect branch predictor to run with",
     )
+    parser.add_argument(
+        "--branch-trace",
+        default=None,
+        type=str,
+        help="""
+                        Write the branches committed by the CPU to this
+                        file in the output directory, to be replayed with
+                        configs/example/bpred_replay.py""",
+    )
 
     parser.add_argument(
         "--list-rp-types",
@@ -766,6 +775,19 @@ def addFSOptions(parser):
         action="store_true",
         help="Prevent simulated time from getting ahead of real time",
     )
+    parser.add_argument(
+        "--parallel-cpus",
+        action="store_true",
+        help="Run each NonCachingSimpleCPU on its own host thread "
+        "(KVM CPUs always are)",
+    )
+    parser.add_argument(
+        "--sim-quantum",
+        action="store",
+        type=str,
+        default="1ms",
+        help="How far CPUs on their own host threads may drift apart",
+    )
 
     # System options
     parser.add_argument("--kernel", action="store", type=str)
@@ -66,6 +66,10 @@ from common.Caches import *
 from common import Options
 
 
+def parallel_cpus(cpu_class):
+    return args.parallel_cpus and ObjectList.is_noncaching_cpu(cpu_class)
+
+
 def cmd_line_template():
     if args.command_line and args.command_line_file:
         print(
@@ -232,10 +236,11 @@ def build_test_system(np):
 
         MemConfig.config_mem(args, test_sys)
 
-    if ObjectList.is_kvm_cpu(TestCPUClass) or ObjectList.is_kvm_cpu(
+    is_kvm = ObjectList.is_kvm_cpu(TestCPUClass) or ObjectList.is_kvm_cpu(
         FutureClass
-    ):
-        # Assign KVM CPUs to their own event queues / threads. This
+    )
+    if is_kvm or parallel_cpus(TestCPUClass):
+        # Assign the CPUs to their own event queues / threads. This
         # has to be done after creating caches and other child objects
         # since these mustn't inherit the CPU event queue.
         for i, cpu in enumerate(test_sys.cpu):
@@ -245,6 +250,7 @@ def build_test_system(np):
             for obj in cpu.descendants():
                 obj.eventq_index = 0
             cpu.eventq_index = i + 1
+    if is_kvm:
         test_sys.kvm_vm = KvmVM()
 
     return test_sys
@@ -403,11 +409,17 @@ else:
     print("Error I don't know how to create more than 2 systems.")
     sys.exit(1)
 
-if ObjectList.is_kvm_cpu(TestCPUClass) or ObjectList.is_kvm_cpu(FutureClass):
-    # Required for running kvm on multiple host cores.
+if (
+    ObjectList.is_kvm_cpu(TestCPUClass)
+    or ObjectList.is_kvm_cpu(FutureClass)
+    or parallel_cpus(TestCPUClass)
+):
+    # Required for running CPUs on multiple host cores.
     # Uses gem5's parallel event queue feature
     # Note: The simulator is quite picky about this number!
-    root.sim_quantum = int(1e9)  # 1 ms
+    root.sim_quantum = m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(args.sim_quantum)
+    )
 
 if args.timesync:
     root.time_sync_enable = True
@@ -256,6 +256,12 @@ for i in range(np):
         )
         system.cpu[i].branchPred.indirectBranchPred = indirectBPClass()
 
+    if args.branch_trace:
+        trace_file = args.branch_trace
+        if np > 1:
+            trace_file += f".{i}"
+        system.cpu[i].branchTrace = BranchTraceProbe(traceFile=trace_file)
+
     system.cpu[i].createThreads()
 
 if args.ruby:
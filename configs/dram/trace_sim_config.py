@@ -0,0 +1,122 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script writes the config.ini of a single memory controller for
+# the standalone trace-driven simulator in util/mem_trace_sim. Nothing
+# is simulated, the controller port is left for the simulator to
+# connect its trace player to.
+
+import argparse
+import os
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+
+parser.add_argument(
+    "--mem-type",
+    default="DDR4_2400_16x4",
+    choices=ObjectList.mem_list.get_names(),
+    help="type of memory to use",
+)
+parser.add_argument(
+    "--mem-size", default="1GB", help="size of the memory behind the controller"
+)
+parser.add_argument(
+    "--hbm",
+    action="store_true",
+    help="use a HBMCtrl with two pseudo channels of --mem-type",
+)
+parser.add_argument(
+    "--sched-policy",
+    default=None,
+    choices=["FRFCFSSchedPolicy", "BLISSSchedPolicy", "ATLASSchedPolicy"],
+    help="scheduling policy object of the controller",
+)
+parser.add_argument(
+    "--config-file",
+    default="config.ini",
+    help="name of the config file written to the output directory",
+)
+
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+)
+
+mem_range = AddrRange(args.mem_size)
+system.mem_ranges = [mem_range]
+
+mem_cls = ObjectList.mem_list.get(args.mem_type)
+if args.hbm:
+    # interleave the pseudo channels at 64 bytes, like the HBM
+    # configurations in MemConfig
+    system.mem_ctrl = HBMCtrl(
+        dram=mem_cls(
+            range=AddrRange(
+                mem_range.start,
+                size=mem_range.size(),
+                masks=[1 << 6],
+                intlvMatch=0,
+            )
+        ),
+        dram_2=mem_cls(
+            range=AddrRange(
+                mem_range.start,
+                size=mem_range.size(),
+                masks=[1 << 6],
+                intlvMatch=1,
+            )
+        ),
+    )
+else:
+    system.mem_ctrl = MemCtrl(dram=mem_cls(range=mem_range))
+
+if args.sched_policy:
+    system.mem_ctrl.sched_policy = getattr(m5.objects, args.sched_policy)()
+
+root = Root(full_system=False, system=system)
+
+# Write the configuration the way m5.instantiate() does, without
+# instantiating anything as the controller port is not connected
+for obj in root.descendants():
+    obj.adoptOrphanParams()
+for obj in root.descendants():
+    obj.unproxyParams()
+
+ini_name = os.path.join(m5.options.outdir, args.config_file)
+with open(ini_name, "w") as ini_file:
+    for obj in sorted(root.descendants(), key=lambda o: o.path()):
+        obj.print_ini(ini_file)
+
+print("Wrote %s for %s" % (ini_name, system.mem_ctrl.path()))
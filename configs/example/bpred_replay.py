@@ -0,0 +1,84 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs a branch trace through a branch predictor, without a CPU. The MPKI
+# (replay.mpki) and the predictor's own statistics end up in stats.txt.
+#
+# Branch traces are written by a BranchTraceProbe attached to a CPU, e.g.,
+# with the --branch-trace option of configs/deprecated/example/se.py:
+#
+#   build/ARM/gem5.opt configs/deprecated/example/se.py --cpu-type=O3CPU \
+#       --caches --branch-trace=branches.trace -c <binary>
+#   build/ARM/gem5.opt configs/example/bpred_replay.py \
+#       --bp-type=TAGE_SC_L_64KB m5out/branches.trace
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument("trace", help="Branch trace to replay")
+parser.add_argument(
+    "--bp-type",
+    default="LTAGE",
+    choices=ObjectList.bp_list.get_names(),
+    help="Type of branch predictor to evaluate",
+)
+parser.add_argument(
+    "--indirect-bp-type",
+    default=None,
+    choices=ObjectList.indirect_bp_list.get_names(),
+    help="Type of indirect branch predictor to evaluate",
+)
+parser.add_argument(
+    "--max-branches",
+    type=int,
+    default=0,
+    help="Number of branches to replay, 0 for the whole trace",
+)
+
+args = parser.parse_args()
+
+bpred = ObjectList.bp_list.get(args.bp_type)()
+if args.indirect_bp_type:
+    bpred.indirectBranchPred = ObjectList.indirect_bp_list.get(
+        args.indirect_bp_type
+    )()
+
+root = Root(full_system=False)
+root.replay = BranchTraceReplay(
+    branchPred=bpred, traceFile=args.trace, maxBranches=args.max_branches
+)
+
+m5.instantiate()
+exit_event = m5.simulate()
+print(f"Exiting because {exit_event.getCause()}")
+m5.stats.dump()
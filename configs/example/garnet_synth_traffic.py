@@ -179,6 +179,9 @@ for ruby_port in system.ruby._cpu_ports:
     # Tie the cpu test ports to the ruby cpu port
     #
     cpus[i].test = ruby_port.in_ports
+    if args.garnet_partitions > 1:
+        # Run each tester on the event queue of its controller
+        cpus[i].eventq_index = ruby_port.get_parent().eventq_index
     i += 1
 
 # -----------------------
@@ -191,6 +194,14 @@ root.system.mem_mode = "timing"
 # Not much point in this being higher than the L1 latency
 m5.ticks.setGlobalFrequency("1ps")
 
+if args.garnet_partitions > 1:
+    # Garnet exchanges traffic between partitions on its own; the global
+    # quantum only bounds how quickly exit requests are noticed.
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = args.link_latency * m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(args.ruby_clock)
+    )
+
 # instantiate configuration
 m5.instantiate()
 
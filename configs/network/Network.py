@@ -126,6 +126,23 @@ def define_options(parser):
         default=50000,
         help="network-level deadlock threshold.",
     )
+    parser.add_argument(
+        "--garnet-partitions",
+        action="store",
+        type=int,
+        default=1,
+        help="""number of event queues (host threads) the garnet
+            routers and network interfaces are spread over. Links
+            between partitions act as lookahead for synchronization.""",
+    )
+    parser.add_argument(
+        "--garnet-fast-mode",
+        action="store_true",
+        default=False,
+        help="""start garnet in its analytical fast mode, e.g. for
+            warmup. Call setFastMode(False) on the network to switch
+            to detailed simulation.""",
+    )
     parser.add_argument(
         "--simple-physical-channels",
         action="store_true",
@@ -187,6 +204,7 @@ def init_network(options, network, InterfaceClass):
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
         network.is_dragonfly = options.is_dragonfly
+        network.fast_mode = options.garnet_fast_mode
 
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
@@ -297,3 +315,39 @@ def init_network(options, network, InterfaceClass):
         assert options.network == "garnet"
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+    if options.network == "garnet" and options.garnet_partitions > 1:
+        partition_network(options, network)
+
+
+def partition_network(options, network):
+    """Spread the garnet routers over options.garnet_partitions event
+    queues. Each network interface and the controller behind it follow the
+    router they attach to. A link runs on the queue of the object feeding
+    it, so the credit link of an internal link goes with its destination
+    router. Partitions are contiguous ranges of router ids, i.e. bands of
+    rows in a mesh, which keeps most links inside a partition."""
+
+    num_parts = options.garnet_partitions
+    num_routers = len(network.routers)
+    if num_parts > num_routers:
+        fatal(
+            "Cannot spread %d routers over %d partitions"
+            % (num_routers, num_parts)
+        )
+
+    def partition_of(router):
+        return router.router_id * num_parts // num_routers
+
+    for router in network.routers:
+        router.eventq_index = partition_of(router)
+
+    for link in network.int_links:
+        link.eventq_index = partition_of(link.src_node)
+        link.credit_link.eventq_index = partition_of(link.dst_node)
+
+    for (i, link) in enumerate(network.ext_links):
+        part = partition_of(link.int_node)
+        link.eventq_index = part
+        link.ext_node.eventq_index = part
+        network.netifs[i].eventq_index = part
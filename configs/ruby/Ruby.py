@@ -74,6 +74,14 @@ def define_options(parser):
         help="Should ruby maintain a second copy of memory",
     )
 
+    parser.add_argument(
+        "--ruby-elide-data",
+        action="store_true",
+        default=False,
+        help="Do not carry data through the ruby caches and memory "
+        "controllers; implies --access-backing-store",
+    )
+
     # Options related to cache structure
     parser.add_argument(
         "--ports",
@@ -175,8 +183,10 @@ def setup_memory_controllers(system, ruby, dir_cntrls, options):
             else:
                 mem_ctrl = dram_intf
 
-            if options.access_backing_store:
+            if options.access_backing_store or options.ruby_elide_data:
                 dram_intf.kvm_map = False
+            if options.ruby_elide_data:
+                dram_intf.null = True
 
             mem_ctrls.append(mem_ctrl)
             dir_ranges.append(dram_intf.range)
@@ -291,8 +301,9 @@ def create_system(
     ruby.num_of_sequencers = len(cpu_sequencers)
 
     # Create a backing copy of physical memory in case required
-    if options.access_backing_store:
+    if options.access_backing_store or options.ruby_elide_data:
         ruby.access_backing_store = True
+        ruby.elide_data = options.ruby_elide_data
         ruby.phys_mem = SimpleMemory(
             range=system.mem_ranges[0], in_addr_map=False
         )
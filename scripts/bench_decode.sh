@@ -0,0 +1,25 @@
+# Host-side decode throughput of the atomic CPU for each ISA.
+# Runs the same binary with and without block execution and reports the
+# simulated instruction rate together with the decode cache statistics,
+# so decoder changes can be compared run against run.
+bash -c '> plot/decode_host_perf.txt'
+
+for isa in ARM POWER RISCV X86
+do
+  bin=${CMD:-tests/test-progs/hello/bin/${isa,,}/linux/hello}
+  for block in 0 1
+  do
+    echo "Running $bin on $isa with block_execution = $block"
+    extra=""
+    if [ $block -eq 1 ]; then
+      extra="--param=system.cpu[0].block_execution=True"
+    fi
+    ./build/$isa/gem5.opt -d m5out/bench_decode configs/deprecated/example/se.py --cpu-type=AtomicSimpleCPU --cmd=$bin $extra
+    host_inst_rate=$(grep "^hostInstRate" m5out/bench_decode/stats.txt | awk '{ print $2 }')
+    addr_hits=$(grep "decodeCache.addrHits" m5out/bench_decode/stats.txt | awk '{ print $2 }')
+    inst_hits=$(grep "decodeCache.instHits" m5out/bench_decode/stats.txt | awk '{ print $2 }')
+    decodes=$(grep "decodeCache.decodes" m5out/bench_decode/stats.txt | awk '{ print $2 }')
+    invalidations=$(grep "decodeCache.invalidations" m5out/bench_decode/stats.txt | awk '{ print $2 }')
+    echo "isa = $isa  block_execution = $block  host_inst_rate = $host_inst_rate  addr_hits = $addr_hits  inst_hits = $inst_hits  decodes = $decodes  invalidations = $invalidations" >> plot/decode_host_perf.txt
+  done
+done
@@ -0,0 +1,16 @@
+# Host-side performance of Garnet at high injection rates.
+# Reports simulator wall-clock time and simulated ticks per host second for
+# each injection rate, so NoC changes can be compared run against run.
+bash -c '> plot/garnet_host_perf.txt'
+
+sim_cycles=${SIM_CYCLES:-1000000}
+
+for injection_rate in 0.2 0.4 0.6 0.8 1.0
+do
+  echo "Running script with injection_rate = $injection_rate"
+  ./build/NULL/gem5.opt -d m5out/bench_garnet configs/example/garnet_synth_traffic.py --network=garnet --num-cpus=64 --num-dirs=64 --topology=Mesh_XY --mesh-rows=8 --routing-algorithm=1 --inj-vnet=0 --synthetic=uniform_random --garnet-deadlock-threshold=50000 --sim-cycles=$sim_cycles --injectionrate=$injection_rate
+  host_seconds=$(grep "^hostSeconds" m5out/bench_garnet/stats.txt | awk '{ print $2 }')
+  host_tick_rate=$(grep "^hostTickRate" m5out/bench_garnet/stats.txt | awk '{ print $2 }')
+  packets_received=$(grep "packets_received::total" m5out/bench_garnet/stats.txt | awk '{ print $2 }')
+  echo "injection_rate = $injection_rate  host_seconds = $host_seconds  host_tick_rate = $host_tick_rate  packets_received = $packets_received" >> plot/garnet_host_perf.txt
+done
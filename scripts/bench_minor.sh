@@ -0,0 +1,22 @@
+# Host-side speed of MinorCPU per simulated instruction.
+# Runs the same binary on a baseline and a modified gem5 build (BEFORE and
+# AFTER, both gem5.opt binaries) and reports the host time spent per
+# simulated instruction, so pipeline changes can be compared run against run.
+bash -c '> plot/minor_host_perf.txt'
+
+isa=${ISA:-X86}
+bin=${CMD:-tests/test-progs/hello/bin/${isa,,}/linux/hello}
+before=${BEFORE:-./build/$isa/gem5.opt.orig}
+after=${AFTER:-./build/$isa/gem5.opt}
+
+for build in before after
+do
+  gem5=${!build}
+  echo "Running $bin on MinorCPU with $gem5"
+  $gem5 -d m5out/bench_minor configs/deprecated/example/se.py --cpu-type=MinorCPU --caches --cmd=$bin
+  host_seconds=$(grep "^hostSeconds" m5out/bench_minor/stats.txt | awk '{ print $2 }')
+  host_inst_rate=$(grep "^hostInstRate" m5out/bench_minor/stats.txt | awk '{ print $2 }')
+  sim_insts=$(grep "^simInsts" m5out/bench_minor/stats.txt | awk '{ print $2 }')
+  ns_per_inst=$(awk -v s=$host_seconds -v n=$sim_insts 'BEGIN { printf "%.1f", s * 1e9 / n }')
+  echo "build = $build  sim_insts = $sim_insts  host_seconds = $host_seconds  host_inst_rate = $host_inst_rate  host_ns_per_inst = $ns_per_inst" >> plot/minor_host_perf.txt
+done
@@ -71,6 +71,8 @@ Decoder::Decoder(const ArmDecoderParams &params)
     smeLen = (safe_cast<ISA *>(params.isa)
             ->getCurSmeVecLenInBitsAtReset() >> 7) - 1;
 
+    updateDecodeMode();
+
     if (dvmEnabled) {
         warn_once(
             "DVM Ops instructions are micro-architecturally "
@@ -151,24 +151,44 @@ class Decoder : public InstDecoder
 
     StaticInstPtr decode(PCStateBase &pc) override;
 
+    void
+    invalidateCode(Addr pc) override
+    {
+        if (defaultCache.invalidate(pc))
+            decodeCacheStats.invalidations++;
+    }
+
   public: // ARM-specific decoder state manipulation
     void
     setContext(FPSCR fpscr)
     {
         fpscrLen = fpscr.len;
         fpscrStride = fpscr.stride;
+        updateDecodeMode();
     }
 
     void
     setSveLen(uint8_t len)
     {
         sveLen = len;
+        updateDecodeMode();
     }
 
     void
     setSmeLen(uint8_t len)
     {
         smeLen = len;
+        updateDecodeMode();
+    }
+
+  private:
+    void
+    updateDecodeMode()
+    {
+        _decodeMode = static_cast<uint8_t>(fpscrLen) |
+            static_cast<uint8_t>(fpscrStride) << 8 |
+            static_cast<uint8_t>(sveLen) << 16 |
+            static_cast<uint64_t>(static_cast<uint8_t>(smeLen)) << 24;
     }
 };
 
@@ -48,6 +48,8 @@ class BasicDecodeCache
     {
         StaticInstPtr inst;
         EMI machInst;
+        /** Generation of the page the entry was filled under. */
+        uint64_t generation = 0;
     };
     decode_cache::AddrMap<AddrMapEntry> decodePages;
 
@@ -59,21 +61,32 @@ class BasicDecodeCache
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
+        const uint64_t generation = decodePages.generation(addr);
+        if (entry.inst && entry.generation == generation &&
+                (entry.machInst == mach_inst)) {
+            decoder->decodeCacheStats.addrHits++;
             return entry.inst;
+        }
 
         entry.machInst = mach_inst;
+        entry.generation = generation;
 
         auto iter = instMap.find(mach_inst);
         if (iter != instMap.end()) {
+            decoder->decodeCacheStats.instHits++;
             entry.inst = iter->second;
             return entry.inst;
         }
 
+        decoder->decodeCacheStats.decodes++;
         entry.inst = decoder->decodeInst(mach_inst);
         instMap[mach_inst] = entry.inst;
         return entry.inst;
     }
+
+    /// Make the instructions cached for the page of an address stale.
+    /// @retval Whether anything was cached for the page.
+    bool invalidate(Addr addr) { return decodePages.invalidate(addr); }
 };
 
 } // namespace GenericISA
@@ -32,6 +32,23 @@
 namespace gem5
 {
 
+InstDecoder::DecodeCacheStats::DecodeCacheStats(statistics::Group *parent)
+    : statistics::Group(parent, "decodeCache"),
+      ADD_STAT(addrHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache by PC"),
+      ADD_STAT(instHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache by machine code"),
+      ADD_STAT(decodes, statistics::units::Count::get(),
+               "Number of instructions decoded from scratch"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of pages dropped from the cache by PC"),
+      ADD_STAT(addrHitRate, statistics::units::Ratio::get(),
+               "Fraction of instructions found in the cache by PC",
+               addrHits / (addrHits + instHits + decodes))
+{
+    addrHitRate.precision(6);
+}
+
 StaticInstPtr
 InstDecoder::fetchRomMicroop(MicroPC micropc, StaticInstPtr curMacroop)
 {
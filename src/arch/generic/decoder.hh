@@ -31,6 +31,7 @@
 #include "arch/generic/pcstate.hh"
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 #include "params/InstDecoder.hh"
@@ -49,12 +50,35 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    /**
+     * Decoder state, beyond the PC and the instruction bytes, that
+     * affects how instructions are decoded (see decodeMode()). ISAs
+     * with such state update it whenever the state changes.
+     */
+    uint64_t _decodeMode = 0;
+
+    struct DecodeCacheStats : public statistics::Group
+    {
+        DecodeCacheStats(statistics::Group *parent);
+
+        /** Found in the cache of instructions by PC. */
+        statistics::Scalar addrHits;
+        /** Found in the cache of instructions by machine code. */
+        statistics::Scalar instHits;
+        /** Decoded from scratch. */
+        statistics::Scalar decodes;
+        /** Pages dropped from the PC cache. */
+        statistics::Scalar invalidations;
+        statistics::Formula addrHitRate;
+    } decodeCacheStats;
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
         SimObject(params), _moreBytesPtr(mb_buf),
         _moreBytesSize(sizeof(MoreBytesType)),
-        _pcMask(~mask(floorLog2(_moreBytesSize)))
+        _pcMask(~mask(floorLog2(_moreBytesSize))),
+        decodeCacheStats(this)
     {}
 
     virtual StaticInstPtr fetchRomMicroop(
@@ -80,6 +104,18 @@ class InstDecoder : public SimObject
         return *static_cast<const Type *>(this);
     }
 
+    /**
+     * Make the instructions cached for the page of a PC stale, e.g.,
+     * because the code on it was modified. Only the atomic CPU calls
+     * this, for every store to a physical page it fetched code from.
+     * Cached instructions are checked against the machine code before
+     * being used anyway, so this only saves keeping stale entries
+     * around.
+     *
+     * @param pc Any PC on the page.
+     */
+    virtual void invalidateCode(Addr pc) {}
+
     /**
      * Take over the state from an old decoder when switching CPUs.
      *
@@ -92,6 +128,14 @@ class InstDecoder : public SimObject
         outOfBytes = old->outOfBytes;
     }
 
+    /**
+     * The mode the decoder currently decodes in, e.g., the operating
+     * mode on x86. The same bytes at the same PC decode to the same
+     * instruction as long as the mode does not change, which CPU models
+     * that reuse decoded instructions across fetches rely on.
+     */
+    uint64_t decodeMode() const { return _decodeMode; }
+
     void *moreBytesPtr() const { return _moreBytesPtr; }
     size_t moreBytesSize() const { return _moreBytesSize; }
     Addr pcMask() const { return _pcMask; }
@@ -94,6 +94,13 @@ class Decoder : public InstDecoder
         instDone = false;
         return decode(emi, next_pc.instAddr());
     }
+
+    void
+    invalidateCode(Addr pc) override
+    {
+        if (defaultCache.invalidate(pc))
+            decodeCacheStats.invalidations++;
+    }
 };
 
 } // namespace MipsISA
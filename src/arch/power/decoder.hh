@@ -91,6 +91,13 @@ class Decoder : public InstDecoder
         instDone = false;
         return decode(emi, next_pc.instAddr());
     }
+
+    void
+    invalidateCode(Addr pc) override
+    {
+        if (defaultCache.invalidate(pc))
+            decodeCacheStats.invalidations++;
+    }
 };
 
 } // namespace PowerISA
@@ -87,8 +87,12 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
             mach_inst.instBits, addr);
 
     StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
+    if (si) {
+        decodeCacheStats.instHits++;
+    } else {
+        decodeCacheStats.decodes++;
         si = decodeInst(mach_inst);
+    }
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
             si->getName(), mach_inst);
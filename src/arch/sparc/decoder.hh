@@ -79,6 +79,7 @@ class Decoder : public InstDecoder
     setContext(RegVal _asi)
     {
         asi = _asi;
+        _decodeMode = asi;
     }
 
   protected:
@@ -109,6 +110,13 @@ class Decoder : public InstDecoder
         instDone = false;
         return decode(emi, next_pc.instAddr());
     }
+
+    void
+    invalidateCode(Addr pc) override
+    {
+        if (defaultCache.invalidate(pc))
+            decodeCacheStats.invalidations++;
+    }
 };
 
 } // namespace SparcISA
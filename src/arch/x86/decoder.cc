@@ -49,6 +49,12 @@ Decoder::doResetState()
     origPC = basePC + offset;
     DPRINTF(Decoder, "Setting origPC to %#x\n", origPC);
     instBytes = &decodePages->lookup(origPC);
+    const uint64_t generation = decodePages->generation(origPC);
+    if (instBytes->generation != generation) {
+        // the code on the page was modified since the entry was filled
+        *instBytes = InstBytes();
+        instBytes->generation = generation;
+    }
     chunkIdx = 0;
 
     emi.rex = 0;
@@ -163,6 +169,7 @@ Decoder::doFromCacheState()
         return PrefixState;
     } else if (chunkIdx == instBytes->chunks.size() - 1) {
         // We matched the cache, so use its value.
+        decodeCacheStats.addrHits++;
         instDone = true;
         offset = instBytes->lastOffset;
         if (offset == sizeof(MachInst))
@@ -681,8 +688,10 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
 
     auto iter = instMap->find(mach_inst);
     if (iter != instMap->end()) {
+        decodeCacheStats.instHits++;
         si = iter->second;
     } else {
+        decodeCacheStats.decodes++;
         si = decodeInst(mach_inst);
         (*instMap)[mach_inst] = si;
     }
@@ -83,8 +83,10 @@ class Decoder : public InstDecoder
         std::vector<MachInst> chunks;
         std::vector<MachInst> masks;
         int lastOffset;
+        /** Generation of the page the entry was filled under. */
+        uint64_t generation;
 
-        InstBytes() : lastOffset(0)
+        InstBytes() : lastOffset(0), generation(0)
         {}
     };
 
@@ -278,6 +280,7 @@ class Decoder : public InstDecoder
         altAddr = m5Reg.altAddr;
         defAddr = m5Reg.defAddr;
         stack = m5Reg.stack;
+        _decodeMode = m5Reg;
 
         AddrCacheMap::iterator amIter = addrCacheMap.find(m5Reg);
         if (amIter != addrCacheMap.end()) {
@@ -296,6 +299,17 @@ class Decoder : public InstDecoder
         }
     }
 
+    void
+    invalidateCode(Addr pc) override
+    {
+        // Pages are cached separately for every mode
+        bool invalidated = false;
+        for (auto &it : addrCacheMap)
+            invalidated |= it.second->invalidate(pc);
+        if (invalidated)
+            decodeCacheStats.invalidations++;
+    }
+
     void
     takeOverFrom(InstDecoder *old) override
     {
@@ -0,0 +1,80 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import *
+
+
+class SamplingController(SimObject):
+    """SMARTS-style sampled simulation. The simulation alternates between
+    functional warming on the warm_cpus and samples on the detailed_cpus.
+    A sample is detailed_warming instructions of detailed warming followed
+    by a measured window of measurement instructions. The statistics are
+    reset at the start of every measured window. m5.simulate() switches the
+    CPUs when the controller asks for it and only returns once the mean
+    CPI of the samples is known to target_error, or on other exits.
+    The mem_ctrls switch to their statistical DRAM model along with the
+    warm_cpus, calibrated from the preceding sample. The model only serves
+    timing requests, so this only helps with warm_cpus in timing mode. The
+    accesses of atomic warm_cpus go to the detailed interface regardless.
+    """
+
+    type = "SamplingController"
+    cxx_header = "cpu/sampling_controller.hh"
+    cxx_class = "gem5::SamplingController"
+
+    cxx_exports = [
+        PyBindMethod("switchPending"),
+        PyBindMethod("switchToDetailed"),
+        PyBindMethod("switched"),
+    ]
+
+    system = Param.System(Parent.any, "System the CPUs belong to")
+    warm_cpus = VectorParam.BaseCPU("CPUs used for functional warming")
+    detailed_cpus = VectorParam.BaseCPU(
+        "CPUs used for samples, switched out at the start"
+    )
+    mem_ctrls = VectorParam.MemCtrl(
+        [], "Controllers using their stat_dram model while warming"
+    )
+
+    functional_warming = Param.Counter(
+        "Instructions of functional warming between two samples"
+    )
+    detailed_warming = Param.Counter(
+        2000, "Instructions of detailed warming before a measured window"
+    )
+    measurement = Param.Counter(1000, "Instructions in a measured window")
+
+    z_score = Param.Float(3.0, "Standard deviations of the confidence level")
+    target_error = Param.Float(
+        0.03,
+        "Relative error of the mean CPI to stop at, 0 to never stop",
+    )
+    min_samples = Param.Unsigned(
+        30, "Samples to take before checking the error"
+    )
+    dump_samples = Param.Bool(
+        False, "Dump the statistics at the end of every measured window"
+    )
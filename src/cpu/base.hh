@@ -183,6 +183,16 @@ class BaseCPU : public ClockedObject
      */
     virtual Port &getInstPort() = 0;
 
+    /**
+     * Called after a thread context wrote to memory functionally
+     * through the data port, e.g., to emulate a system call. Such
+     * writes are not snooped by the CPU itself.
+     *
+     * @param paddr Physical address of the write.
+     * @param size Size of the write in bytes.
+     */
+    virtual void functionalWrite(Addr paddr, Addr size) {}
+
     /** Reads this CPU's ID. */
     int cpuId() const { return _cpuId; }
 
@@ -33,6 +33,7 @@
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -45,11 +46,26 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+/**
+ * A sparse map from an Addr to a Value, stored in page chunks.
+ *
+ * Lookups go through two levels. The first is a small direct-mapped
+ * table indexed by page number that points at the page's chunk, the
+ * second is the chunk itself, indexed by the offset in the page. Only
+ * pages missing from the direct-mapped table need a hash map lookup.
+ *
+ * Pages can be invalidated, e.g., when the code on them was modified.
+ * Rather than clearing the values, this bumps the page's generation.
+ * Users record the generation a value was filled under and treat the
+ * value as stale once the page's generation moved on.
+ */
+template<class Value, Addr CacheChunkShift = 12, size_t NumSlots = 256>
 class AddrMap
 {
   protected:
+    static_assert(isPowerOf2(NumSlots),
+                  "The number of page slots must be a power of 2");
+
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
 
     static constexpr Addr
@@ -68,63 +84,61 @@ class AddrMap
     struct CacheChunk
     {
         Value items[CacheChunkBytes];
+        uint64_t generation = 0;
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
     typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // Direct-mapped table of recently used chunks.
+    struct Slot
+    {
+        // Start of the page, or an unaligned address if unused.
+        Addr tag = 1;
+        CacheChunk *chunk = nullptr;
+    };
+    Slot slots[NumSlots];
+
+    static constexpr size_t
+    slotIndex(Addr addr)
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        return (addr >> CacheChunkShift) & (NumSlots - 1);
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the direct-mapped table, then actually
+    /// look in the hash map.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        Slot &slot = slots[slotIndex(addr)];
+        if (GEM5_LIKELY(slot.tag == chunk_addr))
+            return slot.chunk;
 
         // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
-        }
-
+        CacheChunk *&chunk = chunkMap[chunk_addr];
         // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        if (!chunk)
+            chunk = new CacheChunk;
+
+        slot.tag = chunk_addr;
+        slot.chunk = chunk;
+        return chunk;
     }
 
   public:
-    /// Constructor
-    AddrMap()
+    AddrMap() = default;
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        for (auto &it : chunkMap)
+            delete it.second;
     }
 
     Value &
@@ -133,6 +147,40 @@ class AddrMap
         CacheChunk *chunk = getChunk(addr);
         return chunk->items[chunkOffset(addr)];
     }
+
+    /**
+     * Make all the values on the page of an address stale.
+     *
+     * @param addr Any address on the page.
+     * @return Whether there was anything cached for the page.
+     */
+    bool
+    invalidate(Addr addr)
+    {
+        ChunkIt it = chunkMap.find(chunkStart(addr));
+        if (it == chunkMap.end())
+            return false;
+
+        it->second->generation++;
+        return true;
+    }
+
+    /**
+     * The number of times the page of an address was invalidated. Pages
+     * that were never looked up are not allocated and report 0.
+     */
+    uint64_t
+    generation(Addr addr) const
+    {
+        const Addr chunk_addr = chunkStart(addr);
+
+        const Slot &slot = slots[slotIndex(addr)];
+        if (GEM5_LIKELY(slot.tag == chunk_addr))
+            return slot.chunk->generation;
+
+        auto it = chunkMap.find(chunk_addr);
+        return it == chunkMap.end() ? 0 : it->second->generation;
+    }
 };
 
 } // namespace decode_cache
@@ -44,10 +44,14 @@
 #ifndef __CPU_MINOR_BUFFERS_HH__
 #define __CPU_MINOR_BUFFERS_HH__
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <new>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/named.hh"
@@ -403,7 +407,13 @@ template <typename ElemType,
 class Queue : public Named, public Reservable
 {
   private:
-      std::deque<ElemType> queue;
+    /** Ring of slots allocated up front for capacity elements.  It only
+     *  grows if the queue is pushed beyond its capacity */
+    std::vector<ElemType> queue;
+
+    /** Slot of the head element and number of occupied slots */
+    unsigned int head;
+    unsigned int numElems;
 
     /** Number of slots currently reserved for future (reservation
      *  respecting) pushes */
@@ -415,10 +425,37 @@ class Queue : public Named, public Reservable
     /** Name to use for the data in MinorTrace */
     std::string dataName;
 
+    /** The i-th element from the head */
+    ElemType &
+    elem(unsigned int i)
+    {
+        return queue[(head + i) % queue.size()];
+    }
+
+    const ElemType &
+    elem(unsigned int i) const
+    {
+        return queue[(head + i) % queue.size()];
+    }
+
+    /** Double the ring, moving the elements to its start */
+    void
+    grow()
+    {
+        std::vector<ElemType> grown(queue.size() * 2);
+
+        for (unsigned int i = 0; i < numElems; i++)
+            grown[i] = elem(i);
+        queue.swap(grown);
+        head = 0;
+    }
+
   public:
     Queue(const std::string &name, const std::string &data_name,
         unsigned int capacity_) :
         Named(name),
+        queue(std::max(capacity_, 1u)),
+        head(0), numElems(0),
         numReservedSlots(0),
         capacity(capacity_),
         dataName(data_name)
@@ -433,9 +470,12 @@ class Queue : public Named, public Reservable
     {
         if (!BubbleTraits::isBubble(data)) {
             freeReservation();
-            queue.push_back(data);
+            if (numElems == queue.size())
+                grow();
+            elem(numElems) = data;
+            numElems++;
 
-            if (queue.size() > capacity) {
+            if (numElems > capacity) {
                 warn("%s: No space to push data into queue of capacity"
                     " %u, pushing anyway\n", name(), capacity);
             }
@@ -472,7 +512,7 @@ class Queue : public Named, public Reservable
     unsigned int totalSpace() const { return capacity; }
 
     /** Number of slots already occupied in this buffer */
-    unsigned int occupiedSpace() const { return queue.size(); }
+    unsigned int occupiedSpace() const { return numElems; }
 
     /** Number of slots which are reserved. */
     unsigned int reservedSpace() const { return numReservedSlots; }
@@ -482,7 +522,7 @@ class Queue : public Named, public Reservable
     unsigned int
     remainingSpace() const
     {
-        int ret = capacity - queue.size();
+        int ret = capacity - numElems;
 
         return (ret < 0 ? 0 : ret);
     }
@@ -491,21 +531,33 @@ class Queue : public Named, public Reservable
     unsigned int
     unreservedRemainingSpace() const
     {
-        int ret = capacity - (queue.size() + numReservedSlots);
+        int ret = capacity - (numElems + numReservedSlots);
 
         return (ret < 0 ? 0 : ret);
     }
 
     /** Head value.  Like std::queue::front */
-    ElemType &front() { return queue.front(); }
+    ElemType &front() { return queue[head]; }
 
-    const ElemType &front() const { return queue.front(); }
+    const ElemType &front() const { return queue[head]; }
 
     /** Pop the head item.  Like std::queue::pop */
-    void pop() { queue.pop_front(); }
+    void
+    pop()
+    {
+        assert(numElems != 0);
+        /* Leave a fresh element behind so that references held by the
+         *  popped one are dropped now, as they would be by a deque */
+        ElemType &slot = queue[head];
+        slot.~ElemType();
+        new (&slot) ElemType();
+
+        head = (head + 1) % queue.size();
+        numElems--;
+    }
 
     /** Is the queue empty? */
-    bool empty() const { return queue.empty(); }
+    bool empty() const { return numElems == 0; }
 
     void
     minorTrace() const
@@ -522,7 +574,7 @@ class Queue : public Named, public Reservable
         int num_printed = 1;
         /* Bodge to rotate queue to report elements */
         while (num_printed <= num_occupied) {
-            ReportTraits::reportData(data, queue[num_printed - 1]);
+            ReportTraits::reportData(data, elem(num_printed - 1));
             num_printed++;
 
             if (num_printed <= num_total)
@@ -75,6 +75,52 @@ operator <<(std::ostream &os, const InstId &id)
     return os;
 }
 
+namespace
+{
+
+struct DynInstFreeList
+{
+    struct Node
+    {
+        Node *next;
+    };
+
+    Node *head = nullptr;
+
+    ~DynInstFreeList()
+    {
+        while (head) {
+            Node *node = head;
+            head = node->next;
+            ::operator delete(node);
+        }
+    }
+};
+
+thread_local DynInstFreeList dynInstFreeList;
+
+} // anonymous namespace
+
+void *
+MinorDynInst::operator new(size_t size)
+{
+    assert(size == sizeof(MinorDynInst));
+    if (dynInstFreeList.head) {
+        DynInstFreeList::Node *node = dynInstFreeList.head;
+        dynInstFreeList.head = node->next;
+        return node;
+    }
+    return ::operator new(size);
+}
+
+void
+MinorDynInst::operator delete(void *ptr, size_t size)
+{
+    auto *node = static_cast<DynInstFreeList::Node *>(ptr);
+    node->next = dynInstFreeList.head;
+    dynInstFreeList.head = node;
+}
+
 MinorDynInstPtr MinorDynInst::bubbleInst = []() {
     auto *inst = new MinorDynInst(nullStaticInstPtr);
     assert(inst->isBubble());
@@ -233,14 +233,38 @@ class MinorDynInst : public RefCounted
 
     /** Flat register indices so that, when clearing the scoreboard, we
      *  have the same register indices as when the instruction was marked
-     *  up */
-    std::vector<RegId> flatDestRegIdx;
+     *  up.  Points to inlineDestRegIdx unless the instruction has more
+     *  destinations than fit there */
+    RegId *flatDestRegIdx;
+
+  private:
+    static const unsigned int NumInlineDestRegs = 8;
+
+    RegId inlineDestRegIdx[NumInlineDestRegs];
+    std::unique_ptr<RegId[]> extraDestRegIdx;
 
   public:
     MinorDynInst(StaticInstPtr si, InstId id_=InstId(), Fault fault_=NoFault) :
         staticInst(si), id(id_), fault(fault_), translationFault(NoFault),
-        flatDestRegIdx(si ? si->numDestRegs() : 0)
-    { }
+        flatDestRegIdx(inlineDestRegIdx)
+    {
+        unsigned int num_dests = si ? si->numDestRegs() : 0;
+        if (num_dests > NumInlineDestRegs) {
+            extraDestRegIdx.reset(new RegId[num_dests]);
+            flatDestRegIdx = extraDestRegIdx.get();
+        }
+    }
+
+    /** flatDestRegIdx may point into the instruction itself, so copies
+     *  would share the original's storage */
+    MinorDynInst(const MinorDynInst &) = delete;
+    MinorDynInst &operator=(const MinorDynInst &) = delete;
+
+    /** Instructions are created for every fetched instruction and
+     *  micro-op.  Their storage is recycled through a per-thread free
+     *  list rather than going back to the heap each time */
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
 
   public:
     /** The BubbleIF interface. */
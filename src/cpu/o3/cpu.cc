@@ -119,6 +119,10 @@ CPU::CPU(const BaseO3CPUParams &params)
     fatal_if(FullSystem && params.numThreads > 1,
             "SMT is not supported in O3 in full system mode currently.");
 
+    // Everything in flight is either in the ROB, or on its way to the
+    // IQ and ROB.
+    instList.reserve(params.numROBEntries + params.numIQEntries);
+
     fatal_if(!FullSystem && params.numThreads < params.workload.size(),
             "More workload items (%d) than threads (%d) on CPU %s.",
             params.workload.size(), params.numThreads, name());
@@ -1183,7 +1187,8 @@ CPU::removeInstsNotInROB(ThreadID tid)
     while (inst_it != end_it) {
         assert(!instList.empty());
 
-        squashInstIt(inst_it, tid);
+        if (*inst_it)
+            squashInstIt(inst_it, tid);
 
         inst_it--;
     }
@@ -1210,16 +1215,16 @@ CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
             tid, seq_num, (*inst_iter)->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
-
-        bool break_loop = (inst_iter == instList.begin());
-
-        squashInstIt(inst_iter, tid);
+    // Stepping off the front of the list ends the walk.
+    while (inst_iter != instList.end()) {
+        // Skip instructions of other threads that were already removed.
+        if (*inst_iter) {
+            if ((*inst_iter)->seqNum <= seq_num)
+                break;
+            squashInstIt(inst_iter, tid);
+        }
 
         inst_iter--;
-
-        if (break_loop)
-            break;
     }
 }
 
@@ -1253,11 +1258,18 @@ CPU::cleanUpRemovedInsts()
                 (*removeList.front())->seqNum,
                 (*removeList.front())->pcState());
 
-        instList.erase(removeList.front());
+        // Leave an empty entry behind, and drop it once it reaches
+        // either end of the list.
+        *removeList.front() = nullptr;
 
         removeList.pop();
     }
 
+    while (!instList.empty() && !instList.front())
+        instList.pop_front();
+    while (!instList.empty() && !instList.back())
+        instList.pop_back();
+
     removeInstsThisCycle = false;
 }
 /*
@@ -1277,6 +1289,10 @@ CPU::dumpInsts()
     cprintf("Dumping Instruction List\n");
 
     while (inst_list_it != instList.end()) {
+        if (!*inst_list_it) {
+            inst_list_it++;
+            continue;
+        }
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
                 num, (*inst_list_it)->pcState().instAddr(),
@@ -1318,6 +1334,14 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    if (thread[tid]->status() == gem5::ThreadContext::Active) {
+        // The CPU may be idle, waiting for a long miss, with an
+        // interrupt now pending. Commit has to see it right away.
+        if (_status == Running && drainState() != DrainState::Drained)
+            wakeCPU();
+        return;
+    }
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
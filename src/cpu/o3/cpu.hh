@@ -58,6 +58,7 @@
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
+#include "cpu/o3/inst_window.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
@@ -93,7 +94,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef InstWindow<DynInstPtr>::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -377,8 +378,14 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /**
+     * List of all the instructions in flight. Instructions are removed
+     * at the end of the cycle by cleanUpRemovedInsts(), which leaves an
+     * empty entry behind for those that are not at either end of the
+     * list. That only happens with SMT, when one thread squashes while
+     * younger instructions of another thread are in flight.
+     */
+    InstWindow<DynInstPtr> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -57,6 +57,7 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_window.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
@@ -80,7 +81,7 @@ class DynInst : public ExecContext, public RefCounted
 
   public:
     // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename InstWindow<DynInstPtr>::iterator ListIt;
 
     struct Arrays
     {
@@ -0,0 +1,249 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_WINDOW_HH__
+#define __CPU_O3_INST_WINDOW_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * A window of in-flight instructions, kept in program order in a ring
+ * buffer.
+ *
+ * Instructions are only ever added at the back and removed from either
+ * end, so the window can replace the std::lists the pipeline stages
+ * used to keep without allocating a node per instruction. Every
+ * element gets a position that increases monotonically over the
+ * lifetime of the window and selects its slot in the ring. Iterators
+ * hold on to that position, so like std::list iterators they stay
+ * valid until their own element is removed, even if the ring has to
+ * grow.
+ *
+ * Also like a std::list, stepping an iterator off either end of the
+ * window yields end(), which the squash loops of the pipeline rely on.
+ */
+template <class T>
+class InstWindow
+{
+  private:
+    std::vector<T> slots;
+    uint64_t mask = 0;
+
+    /** Position of the oldest element. */
+    uint64_t head = 0;
+    /** Position after the youngest element. */
+    uint64_t tail = 0;
+
+    static constexpr uint64_t EndPos = ~(uint64_t)0;
+
+    T &slot(uint64_t pos) { return slots[pos & mask]; }
+    const T &slot(uint64_t pos) const { return slots[pos & mask]; }
+
+    void
+    grow(size_t capacity)
+    {
+        capacity = (size_t)1 << ceilLog2(std::max<size_t>(capacity, 2));
+        if (capacity <= slots.size())
+            return;
+
+        std::vector<T> new_slots(capacity);
+        const uint64_t new_mask = capacity - 1;
+        for (uint64_t pos = head; pos != tail; pos++)
+            new_slots[pos & new_mask] = std::move(slot(pos));
+        slots.swap(new_slots);
+        mask = new_mask;
+    }
+
+  public:
+    class iterator
+    {
+      private:
+        InstWindow *window = nullptr;
+        uint64_t pos = EndPos;
+
+        friend class InstWindow;
+
+        iterator(InstWindow *_window, uint64_t _pos) :
+            window(_window), pos(_pos)
+        {}
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        iterator() = default;
+
+        reference operator*() const { return window->slot(pos); }
+        pointer operator->() const { return &window->slot(pos); }
+
+        iterator &
+        operator++()
+        {
+            pos = (pos + 1 == window->tail) ? EndPos : pos + 1;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        iterator &
+        operator--()
+        {
+            if (pos == EndPos)
+                pos = window->empty() ? EndPos : window->tail - 1;
+            else
+                pos = (pos == window->head) ? EndPos : pos - 1;
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        bool
+        operator==(const iterator &other) const
+        {
+            return window == other.window && pos == other.pos;
+        }
+
+        bool
+        operator!=(const iterator &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    InstWindow() = default;
+    explicit InstWindow(size_t capacity) { reserve(capacity); }
+
+    /** Make room for at least the given number of elements. */
+    void reserve(size_t capacity) { grow(capacity); }
+
+    size_t capacity() const { return slots.size(); }
+    size_t size() const { return tail - head; }
+    bool empty() const { return head == tail; }
+
+    iterator
+    begin()
+    {
+        return iterator(this, empty() ? EndPos : head);
+    }
+
+    iterator end() { return iterator(this, EndPos); }
+
+    T &front() { assert(!empty()); return slot(head); }
+    const T &front() const { assert(!empty()); return slot(head); }
+    T &back() { assert(!empty()); return slot(tail - 1); }
+    const T &back() const { assert(!empty()); return slot(tail - 1); }
+
+    /**
+     * Add an element at the back. The ring only grows if it is full,
+     * which should not happen if it was sized for the structure it
+     * models.
+     */
+    void
+    push_back(const T &t)
+    {
+        if (size() == slots.size())
+            grow(slots.size() * 2);
+        slot(tail++) = t;
+    }
+
+    void
+    pop_front()
+    {
+        assert(!empty());
+        // Drop the reference right away, rather than when the slot is
+        // reused.
+        slot(head++) = T();
+    }
+
+    void
+    pop_back()
+    {
+        assert(!empty());
+        slot(--tail) = T();
+    }
+
+    /**
+     * Remove the element an iterator points to, which must be at either
+     * end of the window.
+     *
+     * @return An iterator to the following element.
+     */
+    iterator
+    erase(iterator it)
+    {
+        assert(it.window == this && it.pos != EndPos);
+        if (it.pos == head) {
+            pop_front();
+            return begin();
+        }
+        panic_if(it.pos != tail - 1,
+                 "Instructions can only be removed from either end of "
+                 "the instruction window.");
+        pop_back();
+        return end();
+    }
+
+    void
+    clear()
+    {
+        while (!empty())
+            pop_back();
+        head = tail = 0;
+    }
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_WINDOW_HH__
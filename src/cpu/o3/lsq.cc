@@ -896,6 +896,11 @@ LSQ::SingleDataRequest::finish(const Fault &fault, const RequestPtr &request,
 
         LSQRequest::_inst->fault = fault;
         LSQRequest::_inst->translationCompleted(true);
+
+        // The instruction is waiting on the IQ's deferred list and the
+        // CPU may have gone to sleep in the meantime.
+        if (isDelayed())
+            _port.wakeCPU();
     }
 }
 
@@ -921,6 +926,8 @@ LSQ::SplitDataRequest::finish(const Fault &fault, const RequestPtr &req,
             _inst->strictlyOrdered(_mainReq->isStrictlyOrdered());
             flags.set(Flag::TranslationFinished);
             _inst->translationCompleted(true);
+            if (isDelayed())
+                _port.wakeCPU();
 
             for (i = 0; i < _fault.size() && _fault[i] == NoFault; i++);
             if (i > 0) {
@@ -1307,6 +1307,8 @@ void LSQUnit::schedule(Event& ev, Tick when) { cpu->schedule(ev, when); }
 
 BaseMMU *LSQUnit::getMMUPtr() { return cpu->mmu; }
 
+void LSQUnit::wakeCPU() { iewStage->wakeCPU(); }
+
 unsigned int
 LSQUnit::cacheLineSize()
 {
@@ -394,6 +394,11 @@ class LSQUnit
 
     BaseMMU *getMMUPtr();
 
+    /** Wake the CPU up if it went to sleep, e.g., waiting for a
+     *  delayed translation.
+     */
+    void wakeCPU();
+
   private:
     /** Pointer to the CPU. */
     CPU *cpu;
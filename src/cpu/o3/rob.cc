@@ -64,6 +64,9 @@ ROB::ROB(CPU *_cpu, const BaseO3CPUParams &params)
       numThreads(params.numThreads),
       stats(_cpu)
 {
+    for (ThreadID tid = 0; tid < numThreads; tid++)
+        instList[tid].reserve(numEntries);
+
     //Figure out rob policy
     if (robPolicy == SMTQueuePolicy::Dynamic) {
         //Set Max Entries to Total ROB Capacity
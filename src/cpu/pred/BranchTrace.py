@@ -0,0 +1,58 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import SimObject
+from m5.params import *
+from m5.proxy import *
+from m5.objects.Probe import ProbeListenerObject
+
+
+class BranchTraceProbe(ProbeListenerObject):
+    """Writes the branches committed by a CPU, and the number of
+    instructions committed in between, to a branch trace. The probe
+    manager is the CPU."""
+
+    type = "BranchTraceProbe"
+    cxx_class = "gem5::branch_prediction::BranchTraceProbe"
+    cxx_header = "cpu/pred/branch_trace_probe.hh"
+
+    branchPred = Param.BranchPredictor(
+        Parent.branchPred, "Branch predictor to trace"
+    )
+    traceFile = Param.String(
+        "branches.trace", "Trace file, relative to the output directory"
+    )
+
+
+class BranchTraceReplay(SimObject):
+    """Runs a branch trace through a branch predictor without a CPU, see
+    configs/example/bpred_replay.py."""
+
+    type = "BranchTraceReplay"
+    cxx_class = "gem5::branch_prediction::BranchTraceReplay"
+    cxx_header = "cpu/pred/branch_trace_replay.hh"
+
+    numThreads = Param.Unsigned(1, "Number of threads")
+    branchPred = Param.BranchPredictor("Branch predictor to evaluate")
+    traceFile = Param.String("Branch trace to replay")
+    maxBranches = Param.Counter(0, "Branches to replay, 0 for all")
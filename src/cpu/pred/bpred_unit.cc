@@ -117,6 +117,9 @@ BPredUnit::regProbePoints()
 {
     ppBranches = pmuProbePoint("Branches");
     ppMisses = pmuProbePoint("Misses");
+
+    ppCommittedBranches = new ProbePointArg<BranchTraceRecord>(
+        getProbeManager(), "CommittedBranches");
 }
 
 void
@@ -173,6 +176,12 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     PredictorHistory predict_record(seqNum, pc.instAddr(), pred_taken,
                                     bp_history, indirect_history, tid, inst);
 
+    if (ppCommittedBranches->hasListeners()) {
+        std::unique_ptr<PCStateBase> next(pc.clone());
+        inst->advancePC(*next);
+        predict_record.fallThrough = next->instAddr();
+    }
+
     // Now lookup in the BTB or RAS.
     if (pred_taken) {
         // Note: The RAS may be both popped and pushed to
@@ -321,6 +330,9 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
                     predHist[tid].back().inst,
                     predHist[tid].back().target);
 
+        if (ppCommittedBranches->hasListeners())
+            notifyCommitted(predHist[tid].back());
+
         if (iPred) {
             iPred->commit(done_sn, tid, predHist[tid].back().indirectHistory);
         }
@@ -329,6 +341,27 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
     }
 }
 
+void
+BPredUnit::notifyCommitted(const PredictorHistory &hist)
+{
+    const StaticInstPtr &inst = hist.inst;
+
+    BranchTraceRecord record;
+    record.pc = hist.pc;
+    // The target is fixed on a squash, so it is the one the branch
+    // actually went to by now
+    record.target = hist.target;
+    record.insts = 0;
+    record.size =
+        hist.fallThrough == MaxAddr ? 0 : hist.fallThrough - hist.pc;
+    record.flags = (hist.predTaken ? BranchTraceRecord::Taken : 0) |
+        (inst->isCondCtrl() ? BranchTraceRecord::Conditional : 0) |
+        (inst->isIndirectCtrl() ? BranchTraceRecord::Indirect : 0) |
+        (inst->isCall() ? BranchTraceRecord::Call : 0) |
+        (inst->isReturn() ? BranchTraceRecord::Return : 0);
+    ppCommittedBranches->notify(record);
+}
+
 void
 BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
@@ -46,6 +46,7 @@
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/pred/branch_trace.hh"
 #include "cpu/pred/btb.hh"
 #include "cpu/pred/indirect.hh"
 #include "cpu/pred/ras.hh"
@@ -220,7 +221,8 @@ class BPredUnit : public SimObject
             tid(other.tid), predTaken(other.predTaken), usedRAS(other.usedRAS),
             pushedRAS(other.pushedRAS), wasCall(other.wasCall),
             wasReturn(other.wasReturn), wasIndirect(other.wasIndirect),
-            target(other.target), inst(other.inst)
+            target(other.target), fallThrough(other.fallThrough),
+            inst(other.inst)
         {
             set(RASTarget, other.RASTarget);
         }
@@ -277,12 +279,21 @@ class BPredUnit : public SimObject
          */
         Addr target = MaxAddr;
 
+        /**
+         * Address of the instruction after the branch. Only set if
+         * somebody is listening for committed branches.
+         */
+        Addr fallThrough = MaxAddr;
+
         /** The branch instrction */
         const StaticInstPtr inst;
     };
 
     typedef std::deque<PredictorHistory> History;
 
+    /** Notify the listeners of a committed branch. */
+    void notifyCommitted(const PredictorHistory &hist);
+
     /** Number of the threads for which the branch history is maintained. */
     const unsigned numThreads;
 
@@ -365,6 +376,9 @@ class BPredUnit : public SimObject
     /** Miss-predicted branches */
     probing::PMUUPtr ppMisses;
 
+    /** Committed branches and their outcome */
+    ProbePointArg<BranchTraceRecord> *ppCommittedBranches;
+
     /** @} */
 };
 
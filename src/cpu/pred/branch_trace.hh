@@ -0,0 +1,78 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_HH__
+#define __CPU_PRED_BRANCH_TRACE_HH__
+
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * A committed branch as seen by the branch predictor. Branch traces are
+ * a header followed by these records, little endian, as they are
+ * written by the BranchTraceProbe and replayed by the BranchTraceReplay.
+ */
+struct BranchTraceRecord
+{
+    enum Flags : uint8_t
+    {
+        Taken = 1 << 0,
+        Conditional = 1 << 1,
+        Indirect = 1 << 2,
+        Call = 1 << 3,
+        Return = 1 << 4,
+    };
+
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'B', 'R', 'T', '1'};
+
+    /** Address of the branch. */
+    uint64_t pc;
+    /** Address of the instruction executed after the branch. */
+    uint64_t target;
+    /** Instructions committed since the previous branch, this one included. */
+    uint32_t insts;
+    /** Size of the branch instruction. */
+    uint16_t size;
+    uint8_t flags;
+    uint8_t pad = 0;
+
+    bool taken() const { return flags & Taken; }
+    bool conditional() const { return flags & Conditional; }
+    bool indirect() const { return flags & Indirect; }
+    bool call() const { return flags & Call; }
+    bool ret() const { return flags & Return; }
+};
+
+static_assert(sizeof(BranchTraceRecord) == 24);
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_HH__
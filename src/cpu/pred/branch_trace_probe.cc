@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_probe.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/output.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Records buffered before they are written out. */
+constexpr size_t BufferSize = 4096;
+
+} // anonymous namespace
+
+BranchTraceProbe::BranchTraceProbe(const BranchTraceProbeParams &p)
+    : ProbeListenerObject(p),
+      bpred(p.branchPred),
+      stream(simout.create(p.traceFile, true)->stream()),
+      insts(0)
+{
+    fatal_if(!bpred, "%s needs a branch predictor to listen to.", name());
+
+    stream->write(BranchTraceRecord::Magic, sizeof(BranchTraceRecord::Magic));
+    buffer.reserve(BufferSize);
+
+    registerExitCallback([this]() { flush(); });
+}
+
+void
+BranchTraceProbe::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceProbe, uint64_t> InstListener;
+    listeners.push_back(new InstListener(this, "RetiredInsts",
+                                         &BranchTraceProbe::retiredInsts));
+    listeners.push_back(new BranchListener(*this,
+                                           bpred->getProbeManager()));
+}
+
+void
+BranchTraceProbe::retiredInsts(const uint64_t &count)
+{
+    insts += count;
+}
+
+void
+BranchTraceProbe::committedBranch(const BranchTraceRecord &record)
+{
+    buffer.push_back(record);
+    // The predictor commits branches a bit after the CPU retired them, so
+    // the count is only exact over many branches.
+    buffer.back().insts =
+        std::min<uint64_t>(insts, std::numeric_limits<uint32_t>::max());
+    insts = 0;
+
+    if (buffer.size() == BufferSize)
+        flush();
+}
+
+void
+BranchTraceProbe::flush()
+{
+    stream->write(reinterpret_cast<const char *>(buffer.data()),
+                  buffer.size() * sizeof(BranchTraceRecord));
+    stream->flush();
+    buffer.clear();
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,96 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_PROBE_HH__
+#define __CPU_PRED_BRANCH_TRACE_PROBE_HH__
+
+#include <ostream>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceProbe.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+class BPredUnit;
+
+/**
+ * Writes the branches committed by a CPU to a branch trace that the
+ * BranchTraceReplay can run through any branch predictor without the
+ * CPU. It listens to the committed branches of the branch predictor and
+ * to the instructions retired by the CPU, which is the probe manager.
+ */
+class BranchTraceProbe : public ProbeListenerObject
+{
+  public:
+    BranchTraceProbe(const BranchTraceProbeParams &params);
+
+    void regProbeListeners() override;
+
+    void retiredInsts(const uint64_t &count);
+    void committedBranch(const BranchTraceRecord &record);
+
+    /** Write out the buffered records. */
+    void flush();
+
+  private:
+    /** Listens to a probe of another object than the manager. */
+    class BranchListener : public ProbeListenerArgBase<BranchTraceRecord>
+    {
+      private:
+        BranchTraceProbe &probe;
+
+      public:
+        BranchListener(BranchTraceProbe &_probe, ProbeManager *pm)
+            : ProbeListenerArgBase(pm, "CommittedBranches"), probe(_probe)
+        {}
+
+        void
+        notify(const BranchTraceRecord &record) override
+        {
+            probe.committedBranch(record);
+        }
+    };
+
+    BPredUnit *bpred;
+
+    std::ostream *stream;
+
+    /** Instructions retired since the last branch. */
+    uint64_t insts;
+
+    /** Records not written yet. */
+    std::vector<BranchTraceRecord> buffer;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_PROBE_HH__
@@ -0,0 +1,231 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replay.hh"
+
+#include <cstring>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/logging.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Records read from the trace at a time. */
+constexpr size_t ChunkSize = 4096;
+
+/**
+ * Size assumed for the branches of traces that do not record it. It
+ * only matters for the return addresses pushed on the RAS.
+ */
+constexpr unsigned DefaultInstSize = 4;
+
+typedef GenericISA::SimplePCState<DefaultInstSize> PCState;
+
+/** A branch as the predictor sees it, given the type of a record. */
+class ReplayBranch : public StaticInst
+{
+  public:
+    ReplayBranch(uint8_t type) : StaticInst("branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+        if (type & BranchTraceRecord::Conditional)
+            flags[IsCondControl] = true;
+        else
+            flags[IsUncondControl] = true;
+        if (type & BranchTraceRecord::Indirect)
+            flags[IsIndirectControl] = true;
+        else
+            flags[IsDirectControl] = true;
+        flags[IsCall] = type & BranchTraceRecord::Call;
+        flags[IsReturn] = type & BranchTraceRecord::Return;
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Replayed branches are not executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        // The next PC is set to the fall through of the branch
+        pc.advance();
+    }
+
+    std::unique_ptr<PCStateBase>
+    buildRetPC(const PCStateBase &cur_pc,
+               const PCStateBase &call_pc) const override
+    {
+        std::unique_ptr<PCStateBase> ret(call_pc.clone());
+        ret->advance();
+        return ret;
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceReplay::BranchTraceReplay(const BranchTraceReplayParams &p)
+    : SimObject(p),
+      bpred(p.branchPred),
+      trace(p.traceFile, std::ios::binary),
+      traceFile(p.traceFile),
+      maxBranches(p.maxBranches),
+      seqNum(0),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(!trace, "Failed to open branch trace %s.", traceFile);
+
+    char magic[sizeof(BranchTraceRecord::Magic)];
+    fatal_if(!trace.read(magic, sizeof(magic)) ||
+             memcmp(magic, BranchTraceRecord::Magic, sizeof(magic)) != 0,
+             "%s is not a branch trace.", traceFile);
+
+    for (uint8_t type = 0; type < branches.size(); type++)
+        branches[type] = new ReplayBranch(type);
+}
+
+BranchTraceReplay::BranchTraceReplayStats::BranchTraceReplayStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions committed along with the branches"),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches replayed"),
+      ADD_STAT(indirectBranches, statistics::units::Count::get(),
+               "Number of indirect branches replayed"),
+      ADD_STAT(mispredicted, statistics::units::Count::get(),
+               "Number of mispredicted branches"),
+      ADD_STAT(condMispredicted, statistics::units::Count::get(),
+               "Number of mispredicted conditional branches"),
+      ADD_STAT(indirectMispredicted, statistics::units::Count::get(),
+               "Number of mispredicted indirect branches"),
+      ADD_STAT(mpki, statistics::units::Ratio::get(),
+               "Mispredicted branches per thousand instructions",
+               mispredicted * 1000 / insts),
+      ADD_STAT(condMPKI, statistics::units::Ratio::get(),
+               "Mispredicted conditional branches per thousand instructions",
+               condMispredicted * 1000 / insts),
+      ADD_STAT(indirectMPKI, statistics::units::Ratio::get(),
+               "Mispredicted indirect branches per thousand instructions",
+               indirectMispredicted * 1000 / insts),
+      ADD_STAT(accuracy, statistics::units::Ratio::get(),
+               "Fraction of branches predicted correctly",
+               1 - mispredicted / branches)
+{
+    mpki.precision(4);
+    condMPKI.precision(4);
+    indirectMPKI.precision(4);
+    accuracy.precision(6);
+}
+
+void
+BranchTraceReplay::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplay::replay()
+{
+    std::vector<BranchTraceRecord> chunk(ChunkSize);
+    Counter replayed = 0;
+    bool done = false;
+
+    while (!done) {
+        trace.read(reinterpret_cast<char *>(chunk.data()),
+                   chunk.size() * sizeof(BranchTraceRecord));
+        size_t count = trace.gcount() / sizeof(BranchTraceRecord);
+        done = count < chunk.size();
+
+        for (size_t i = 0; i < count; i++) {
+            if (maxBranches && replayed == maxBranches) {
+                done = true;
+                break;
+            }
+            replayBranch(chunk[i]);
+            replayed++;
+        }
+    }
+
+    exitSimLoop("branch trace replayed");
+}
+
+void
+BranchTraceReplay::replayBranch(const BranchTraceRecord &record)
+{
+    const uint8_t type = record.flags & ~BranchTraceRecord::Taken;
+    const StaticInstPtr &inst = branches[type];
+    const bool taken = record.taken();
+
+    ++seqNum;
+
+    PCState pc(record.pc);
+    pc.npc(record.pc + (record.size ? record.size : DefaultInstSize));
+    bool pred_taken = bpred->predict(inst, seqNum, pc, 0);
+
+    stats.insts += record.insts;
+    ++stats.branches;
+    if (record.conditional())
+        ++stats.condBranches;
+    if (record.indirect())
+        ++stats.indirectBranches;
+
+    if (pred_taken != taken || pc.instAddr() != record.target) {
+        ++stats.mispredicted;
+        if (record.conditional())
+            ++stats.condMispredicted;
+        if (record.indirect())
+            ++stats.indirectMispredicted;
+
+        PCState target(record.target);
+        bpred->squash(seqNum, target, taken, 0);
+    }
+
+    bpred->update(seqNum, 0);
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,110 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+
+#include <array>
+#include <fstream>
+
+#include "base/statistics.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "cpu/static_inst.hh"
+#include "params/BranchTraceReplay.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+class BPredUnit;
+
+/**
+ * Runs a branch trace written by the BranchTraceProbe through a branch
+ * predictor, without a CPU, and exits the simulation when done.
+ *
+ * Each branch is predicted, resolved and committed before the next one
+ * is predicted, so the predictor never sees wrong-path branches. The
+ * predictor's own statistics are dumped as usual, next to the MPKI of
+ * the replay.
+ */
+class BranchTraceReplay : public SimObject
+{
+  public:
+    BranchTraceReplay(const BranchTraceReplayParams &params);
+
+    void startup() override;
+
+  private:
+    /** Replay the whole trace. */
+    void replay();
+
+    /** Predict, resolve and commit one branch. */
+    void replayBranch(const BranchTraceRecord &record);
+
+    BPredUnit *bpred;
+
+    std::ifstream trace;
+
+    const std::string traceFile;
+
+    /** Stop after this many branches, 0 to replay the whole trace. */
+    const Counter maxBranches;
+
+    /** Sequence number of the last replayed branch. */
+    InstSeqNum seqNum;
+
+    /** Branch instructions, indexed by the type flags of the records. */
+    std::array<StaticInstPtr, BranchTraceRecord::Return << 1> branches;
+
+    EventFunctionWrapper replayEvent;
+
+    struct BranchTraceReplayStats : public statistics::Group
+    {
+        BranchTraceReplayStats(statistics::Group *parent);
+
+        /** Instructions committed along with the branches. */
+        statistics::Scalar insts;
+        statistics::Scalar branches;
+        statistics::Scalar condBranches;
+        statistics::Scalar indirectBranches;
+        statistics::Scalar mispredicted;
+        statistics::Scalar condMispredicted;
+        statistics::Scalar indirectMispredicted;
+        statistics::Formula mpki;
+        statistics::Formula condMPKI;
+        statistics::Formula indirectMPKI;
+        statistics::Formula accuracy;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
@@ -0,0 +1,183 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_FOLDED_HISTORY_HH__
+#define __CPU_PRED_FOLDED_HISTORY_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * The folded (compressed) global histories of the tagged tables of a
+ * TAGE predictor, mixed with the PC to index and tag the tables.
+ *
+ * Every table has three folded histories, one for the index and two for
+ * the tag. They are stored as arrays rather than one object per history,
+ * so that all of them are updated in a single loop the compiler can
+ * vectorize. Table 0, the bimodal table, has no history and its folded
+ * histories stay 0.
+ */
+class FoldedHistories
+{
+  public:
+    /** Which of the three folded histories of a table. */
+    enum Kind
+    {
+        Index = 0,
+        Tag0,
+        Tag1,
+        NumKinds
+    };
+
+    /**
+     * Allocate the folded histories of a number of tables.
+     *
+     * @param num_tables Number of tables, the bimodal one included.
+     */
+    void
+    resize(int num_tables)
+    {
+        numTables = num_tables;
+        const int n = NumKinds * num_tables;
+        comp.assign(n, 0);
+        origLength.assign(n, 0);
+        compLength.assign(n, 0);
+        outpoint.assign(n, 0);
+        compMask.assign(n, 0);
+        outBits.assign(n, 0);
+    }
+
+    /**
+     * Set the lengths of a folded history.
+     *
+     * @param kind Which of the folded histories of the table.
+     * @param table The table.
+     * @param original_length Number of global history bits folded.
+     * @param compressed_length Width of the folded history.
+     */
+    void
+    init(Kind kind, int table, int original_length, int compressed_length)
+    {
+        assert(table > 0 && table < numTables);
+        const int i = kind * numTables + table;
+        origLength[i] = original_length;
+        compLength[i] = compressed_length;
+        outpoint[i] = original_length % compressed_length;
+        compMask[i] = (1ULL << compressed_length) - 1;
+    }
+
+    unsigned index(int table) const { return comp[table]; }
+    unsigned &index(int table) { return comp[table]; }
+
+    unsigned
+    tag(int which, int table) const
+    {
+        return comp[(Tag0 + which) * numTables + table];
+    }
+
+    unsigned &
+    tag(int which, int table)
+    {
+        return comp[(Tag0 + which) * numTables + table];
+    }
+
+    /**
+     * Shift the newest global history bit into all the folded histories
+     * and the bit leaving their window out of them.
+     *
+     * @param h The global history, newest bit first.
+     */
+    void
+    update(const uint8_t *h)
+    {
+        const int n = comp.size();
+        const unsigned newest = h[0];
+
+        // Gather the bits leaving the histories first, so that the loop
+        // below only works on the arrays
+        for (int i = 0; i < n; i++)
+            outBits[i] = h[origLength[i]];
+
+        unsigned *c = comp.data();
+        const unsigned *out = outBits.data();
+        const int *clen = compLength.data();
+        const int *opoint = outpoint.data();
+        const unsigned *cmask = compMask.data();
+        for (int i = 0; i < n; i++) {
+            unsigned v = (c[i] << 1) | newest;
+            v ^= out[i] << opoint[i];
+            v ^= v >> clen[i];
+            c[i] = v & cmask[i];
+        }
+    }
+
+    /** Save the folded histories of tables 1 to numTables - 1. */
+    void
+    save(int *ci, int *ct0, int *ct1) const
+    {
+        for (int i = 1; i < numTables; i++) {
+            ci[i] = index(i);
+            ct0[i] = tag(0, i);
+            ct1[i] = tag(1, i);
+        }
+    }
+
+    /** Restore folded histories saved with save(). */
+    void
+    restore(const int *ci, const int *ct0, const int *ct1)
+    {
+        for (int i = 1; i < numTables; i++) {
+            index(i) = ci[i];
+            tag(0, i) = ct0[i];
+            tag(1, i) = ct1[i];
+        }
+    }
+
+  private:
+    int numTables = 0;
+
+    /** The folded histories: the index ones, then the two tag ones. */
+    std::vector<unsigned> comp;
+    std::vector<int> origLength;
+    std::vector<int> compLength;
+    /** Position of the bit leaving the window in the folded history. */
+    std::vector<int> outpoint;
+    std::vector<unsigned> compMask;
+
+    /** Scratch space for the bits leaving the histories. */
+    std::vector<unsigned> outBits;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_FOLDED_HISTORY_HH__
@@ -0,0 +1,177 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "cpu/pred/folded_history.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** One folded history at a time, as TAGE used to compute them. */
+struct ReferenceFoldedHistory
+{
+    unsigned comp = 0;
+    int compLength;
+    int origLength;
+    int outpoint;
+
+    void
+    init(int original_length, int compressed_length)
+    {
+        origLength = original_length;
+        compLength = compressed_length;
+        outpoint = original_length % compressed_length;
+    }
+
+    void
+    update(const uint8_t *h)
+    {
+        comp = (comp << 1) | h[0];
+        comp ^= h[origLength] << outpoint;
+        comp ^= (comp >> compLength);
+        comp &= (1ULL << compLength) - 1;
+    }
+};
+
+/**
+ * Run random branch outcomes, squashes included, through the folded
+ * histories and the reference ones and check they always match.
+ *
+ * @param hist_lengths History length of each table, 0 for the bimodal.
+ * @param index_widths Index folded history widths.
+ * @param tag_widths Tag folded history widths.
+ */
+void
+checkAgainstReference(const std::vector<int> &hist_lengths,
+                      const std::vector<int> &index_widths,
+                      const std::vector<int> &tag_widths)
+{
+    const int num_tables = hist_lengths.size();
+    const int max_hist = hist_lengths.back();
+
+    FoldedHistories folded;
+    folded.resize(num_tables);
+    std::vector<ReferenceFoldedHistory> ref_index(num_tables);
+    std::vector<ReferenceFoldedHistory> ref_tag0(num_tables);
+    std::vector<ReferenceFoldedHistory> ref_tag1(num_tables);
+    for (int i = 1; i < num_tables; i++) {
+        folded.init(FoldedHistories::Index, i, hist_lengths[i],
+                    index_widths[i]);
+        folded.init(FoldedHistories::Tag0, i, hist_lengths[i],
+                    tag_widths[i]);
+        folded.init(FoldedHistories::Tag1, i, hist_lengths[i],
+                    tag_widths[i] - 1);
+        ref_index[i].init(hist_lengths[i], index_widths[i]);
+        ref_tag0[i].init(hist_lengths[i], tag_widths[i]);
+        ref_tag1[i].init(hist_lengths[i], tag_widths[i] - 1);
+    }
+
+    // A global history buffer, newest bit first, as in TAGEBase
+    const int buffer_size = 4 * max_hist;
+    std::vector<uint8_t> global(buffer_size + max_hist + 1, 0);
+    int pt = buffer_size;
+
+    std::vector<int> ci(num_tables), ct0(num_tables), ct1(num_tables);
+    std::mt19937 rng(num_tables);
+
+    for (int n = 0; n < 200000; n++) {
+        if (pt == 0) {
+            // Move the newest bits back to the end of the buffer
+            for (int i = 0; i <= max_hist; i++)
+                global[buffer_size + i] = global[i];
+            pt = buffer_size;
+        }
+        pt--;
+        global[pt] = rng() & 1;
+        const uint8_t *h = &global[pt];
+
+        // Sometimes squash: restore the saved histories and update them
+        // again, as TAGEBase::squash() does
+        const bool squash = (rng() % 16) == 0;
+        if (!squash)
+            folded.save(ci.data(), ct0.data(), ct1.data());
+        else
+            folded.restore(ci.data(), ct0.data(), ct1.data());
+
+        folded.update(h);
+        for (int i = 1; i < num_tables; i++) {
+            if (squash) {
+                ref_index[i].comp = ci[i];
+                ref_tag0[i].comp = ct0[i];
+                ref_tag1[i].comp = ct1[i];
+            }
+            ref_index[i].update(h);
+            ref_tag0[i].update(h);
+            ref_tag1[i].update(h);
+        }
+
+        ASSERT_EQ(folded.index(0), 0u);
+        ASSERT_EQ(folded.tag(0, 0), 0u);
+        ASSERT_EQ(folded.tag(1, 0), 0u);
+        for (int i = 1; i < num_tables; i++) {
+            ASSERT_EQ(folded.index(i), ref_index[i].comp);
+            ASSERT_EQ(folded.tag(0, i), ref_tag0[i].comp);
+            ASSERT_EQ(folded.tag(1, i), ref_tag1[i].comp);
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** The default TAGE configuration. */
+TEST(FoldedHistoriesTest, TAGE)
+{
+    checkAgainstReference(
+        {0, 5, 9, 15, 25, 44, 76, 130},
+        {0, 10, 10, 10, 10, 10, 10, 10},
+        {0, 7, 7, 8, 8, 9, 10, 11});
+}
+
+/** The TAGE-SC-L 8KB configuration, with its hardcoded widths. */
+TEST(FoldedHistoriesTest, TAGE_SC_L_8KB)
+{
+    std::vector<int> hist_lengths = {0};
+    std::vector<int> index_widths = {0};
+    std::vector<int> tag_widths = {0};
+    for (int i = 1; i <= 30; i++) {
+        hist_lengths.push_back(4 + (i - 1) * 12);
+        index_widths.push_back(17 + (2 * ((i - 1) / 2) % 4));
+        tag_widths.push_back(13);
+    }
+    checkAgainstReference(hist_lengths, index_widths, tag_widths);
+}
+
+/** Folded histories longer than the histories they fold. */
+TEST(FoldedHistoriesTest, ShortHistories)
+{
+    checkAgainstReference({0, 2, 3, 4}, {0, 12, 12, 12}, {0, 9, 9, 9});
+}
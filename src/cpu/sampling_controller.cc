@@ -0,0 +1,214 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling_controller.hh"
+
+#include <cmath>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "debug/Sampling.hh"
+#include "sim/sim_exit.hh"
+#include "sim/stat_control.hh"
+
+namespace gem5
+{
+
+// Keep in sync with src/python/m5/simulate.py
+const std::string SamplingController::SwitchCause =
+    "sampling controller switching cpus";
+
+SamplingController::SamplingController(const SamplingControllerParams &p)
+    : SimObject(p),
+      warmCpus(p.warm_cpus),
+      detailedCpus(p.detailed_cpus),
+      functionalWarming(p.functional_warming),
+      detailedWarming(p.detailed_warming),
+      measurement(p.measurement),
+      zScore(p.z_score),
+      targetError(p.target_error),
+      minSamples(p.min_samples),
+      dumpSamples(p.dump_samples),
+      phase(FunctionalWarming),
+      pendingSwitch(false),
+      phaseEvent([this]{ phaseDone(); }, name()),
+      startCycles(detailedCpus.size()),
+      startInsts(detailedCpus.size()),
+      numSamples(0),
+      cpiMean(0),
+      cpiM2(0),
+      stats(*this)
+{
+    fatal_if(warmCpus.empty() || warmCpus.size() != detailedCpus.size(),
+             "%s needs as many warming as detailed CPUs.", name());
+    fatal_if(functionalWarming == 0 || measurement == 0,
+             "%s: Empty functional warming or measured windows.", name());
+}
+
+SamplingController::SamplingStats::SamplingStats(SamplingController &sc)
+    : statistics::Group(&sc),
+      ADD_STAT(samples, statistics::units::Count::get(),
+               "Number of measured windows"),
+      ADD_STAT(cpi, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Mean CPI of the measured windows"),
+      ADD_STAT(cpiStdDev, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Standard deviation of the CPI of the measured windows"),
+      ADD_STAT(cpiError, statistics::units::Ratio::get(),
+               "Relative error of the mean CPI at the confidence level")
+{
+    samples.functor([&sc]() { return sc.numSamples; });
+    cpi.functor([&sc]() { return sc.cpiMean; }).precision(6);
+    cpiStdDev.functor([&sc]() {
+            return sc.numSamples > 1 ?
+                std::sqrt(sc.cpiM2 / (sc.numSamples - 1)) : 0.0;
+        }).precision(6);
+    cpiError.functor([&sc]() { return sc.relativeError(); }).precision(6);
+}
+
+const std::vector<BaseCPU *> &
+SamplingController::activeCpus() const
+{
+    return phase == FunctionalWarming ? warmCpus : detailedCpus;
+}
+
+void
+SamplingController::startup()
+{
+    fatal_if(warmCpus[0]->switchedOut(),
+             "%s: Sampling has to start with the warming CPUs.", name());
+    schedulePhaseEnd(functionalWarming);
+}
+
+void
+SamplingController::schedulePhaseEnd(Counter insts)
+{
+    ThreadContext *tc = activeCpus()[0]->getContext(0);
+    tc->scheduleInstCountEvent(&phaseEvent,
+                               tc->getCurrentInstCount() + insts);
+}
+
+void
+SamplingController::phaseDone()
+{
+    switch (phase) {
+      case FunctionalWarming:
+        DPRINTF(Sampling, "Functional warming done, switching to the "
+                "detailed CPUs.\n");
+        pendingSwitch = true;
+        exitSimLoop(SwitchCause);
+        break;
+      case DetailedWarming:
+        startMeasurement();
+        break;
+      case Measurement:
+        endMeasurement();
+        break;
+    }
+}
+
+void
+SamplingController::switched()
+{
+    panic_if(!pendingSwitch, "%s: CPUs switched unexpectedly.", name());
+    pendingSwitch = false;
+
+    if (phase == FunctionalWarming) {
+        phase = DetailedWarming;
+        if (detailedWarming)
+            schedulePhaseEnd(detailedWarming);
+        else
+            startMeasurement();
+    } else {
+        phase = FunctionalWarming;
+        schedulePhaseEnd(functionalWarming);
+    }
+}
+
+void
+SamplingController::startMeasurement()
+{
+    DPRINTF(Sampling, "Starting measured window %d.\n", numSamples);
+
+    phase = Measurement;
+    for (int i = 0; i < detailedCpus.size(); i++) {
+        startCycles[i] = detailedCpus[i]->curCycle();
+        startInsts[i] = detailedCpus[i]->getCurrentInstCount(0);
+    }
+
+    // Only keep the statistics of the measured windows.
+    statistics::schedStatEvent(false, true);
+
+    schedulePhaseEnd(measurement);
+}
+
+void
+SamplingController::endMeasurement()
+{
+    Cycles cycles(0);
+    Counter insts = 0;
+    for (int i = 0; i < detailedCpus.size(); i++) {
+        cycles += detailedCpus[i]->curCycle() - startCycles[i];
+        insts += detailedCpus[i]->getCurrentInstCount(0) - startInsts[i];
+    }
+
+    // Welford's online mean and variance
+    const double sample_cpi = double(cycles) / insts;
+    numSamples++;
+    const double delta = sample_cpi - cpiMean;
+    cpiMean += delta / numSamples;
+    cpiM2 += delta * (sample_cpi - cpiMean);
+
+    DPRINTF(Sampling, "Measured window %d: CPI %f, mean %f, error %f.\n",
+            numSamples - 1, sample_cpi, cpiMean, relativeError());
+
+    if (dumpSamples)
+        statistics::schedStatEvent(true, false);
+
+    if (targetError > 0 && numSamples >= minSamples &&
+            relativeError() <= targetError) {
+        exitSimLoop("sampling reached the target error");
+        // Stay on the detailed CPUs if the simulation goes on.
+        phase = DetailedWarming;
+        return;
+    }
+
+    pendingSwitch = true;
+    exitSimLoop(SwitchCause);
+}
+
+double
+SamplingController::relativeError() const
+{
+    if (numSamples < 2 || cpiMean == 0)
+        return 0;
+    const double std_dev = std::sqrt(cpiM2 / (numSamples - 1));
+    return zScore * std_dev / std::sqrt(numSamples) / cpiMean;
+}
+
+} // namespace gem5
@@ -0,0 +1,144 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SAMPLING_CONTROLLER_HH__
+#define __CPU_SAMPLING_CONTROLLER_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/SamplingController.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+
+/**
+ * Drives SMARTS-style sampled simulation. Execution alternates between
+ * functional warming on fast CPUs (e.g. atomic CPUs with caches) and
+ * samples on detailed CPUs. Each sample is a detailed warming interval
+ * followed by a measured window. Phases are counted in instructions
+ * committed by the first thread of the first CPU.
+ *
+ * The controller tracks the CPI of the measured windows and stops the
+ * simulation once the mean is known to the target relative error. The
+ * statistics are reset at the start of every measured window and can
+ * be dumped at its end.
+ *
+ * Switching CPUs needs the system to be drained, which the controller
+ * asks m5.simulate() for by exiting the simulation loop with
+ * SwitchCause. m5.simulate() then switches the CPUs, calls switched()
+ * and carries on, so scripts do not see these exits.
+ */
+class SamplingController : public SimObject
+{
+  public:
+    /** Exit cause asking for the CPUs to be switched. */
+    static const std::string SwitchCause;
+
+    SamplingController(const SamplingControllerParams &p);
+
+    void startup() override;
+
+    /** Whether the CPUs need to be switched before simulating on. */
+    bool switchPending() const { return pendingSwitch; }
+
+    /** Whether the pending switch is to the detailed CPUs. */
+    bool switchToDetailed() const { return phase == FunctionalWarming; }
+
+    /** Start the next phase once the CPUs were switched. */
+    void switched();
+
+  private:
+    enum Phase
+    {
+        FunctionalWarming,
+        DetailedWarming,
+        Measurement
+    };
+
+    /** The CPUs currently simulating. */
+    const std::vector<BaseCPU *> &activeCpus() const;
+
+    /** Run the current phase for a number of instructions. */
+    void schedulePhaseEnd(Counter insts);
+
+    void phaseDone();
+    void startMeasurement();
+    void endMeasurement();
+
+    /** Relative error of the mean CPI at the configured confidence. */
+    double relativeError() const;
+
+    const std::vector<BaseCPU *> warmCpus;
+    const std::vector<BaseCPU *> detailedCpus;
+
+    /** Instructions of functional warming between two samples. */
+    const Counter functionalWarming;
+    const Counter detailedWarming;
+    const Counter measurement;
+
+    /** Number of standard deviations of the confidence interval. */
+    const double zScore;
+    const double targetError;
+    const unsigned minSamples;
+    const bool dumpSamples;
+
+    Phase phase;
+    bool pendingSwitch;
+
+    EventFunctionWrapper phaseEvent;
+
+    /** Cycles and instructions of the detailed CPUs at the window start. */
+    std::vector<Cycles> startCycles;
+    std::vector<Counter> startInsts;
+
+    /** Running mean and sum of squared deviations of the sample CPIs. */
+    unsigned numSamples;
+    double cpiMean;
+    double cpiM2;
+
+    /**
+     * These statistics describe all the samples, so they are computed
+     * from the state above rather than kept in (resettable) counters.
+     */
+    struct SamplingStats : public statistics::Group
+    {
+        SamplingStats(SamplingController &sc);
+
+        statistics::Value samples;
+        statistics::Value cpi;
+        statistics::Value cpiStdDev;
+        statistics::Value cpiError;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLING_CONTROLLER_HH__
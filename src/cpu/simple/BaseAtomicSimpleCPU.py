@@ -62,6 +62,21 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
 
+    block_execution = Param.Bool(
+        False,
+        "Cache decoded basic blocks and run a whole block per tick "
+        "without fetching or decoding it. Meant for fast-forwarding: "
+        "instruction fetches of cached blocks do not reach the icache, "
+        "and code changed by other agents is only noticed if their "
+        "writes are snooped by the data port.",
+    )
+    block_cache_blocks = Param.Unsigned(
+        65536, "Maximum number of cached blocks before the cache is flushed"
+    )
+    max_block_insts = Param.Unsigned(
+        64, "Maximum number of instructions in a cached block"
+    )
+
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
         simpoint.interval = interval
@@ -44,6 +44,12 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
     is as a substitute for hardware virtualized CPUs when
     stress-testing the memory system.
 
+    Like hardware virtualized CPUs, the CPUs can be put on their own
+    event queues (eventq_index) to fast-forward in parallel, with the
+    Root's sim_quantum bounding how far they drift apart. This mode
+    does not support block_execution, and writes by DMA devices do not
+    break the load-locked reservations of the CPUs.
+
     """
 
     type = "BaseNonCachingSimpleCPU"
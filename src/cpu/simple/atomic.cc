@@ -41,6 +41,8 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <algorithm>
+
 #include "arch/generic/decoder.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
@@ -84,6 +86,10 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       ppCommit(nullptr)
 {
     _status = Idle;
+    if (p.block_execution) {
+        blockCache = std::make_unique<InstBlockCache>(
+            this, p.block_cache_blocks, p.max_block_insts);
+    }
     ifetch_req = std::make_shared<Request>();
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
@@ -148,6 +154,13 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back, e.g., by restoring
+    // a checkpoint, so start over with an empty block cache.
+    if (blockCache) {
+        endBlock();
+        blockCache->flush();
+    }
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -193,6 +206,9 @@ AtomicSimpleCPU::switchOut()
 {
     BaseSimpleCPU::switchOut();
 
+    if (blockCache)
+        endBlock();
+
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
@@ -298,6 +314,8 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        static_cast<AtomicSimpleCPU *>(cpu)->invalidateBlocks(
+            pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +343,11 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite()) {
+        static_cast<AtomicSimpleCPU *>(cpu)->invalidateBlocks(
+            pkt->getAddr(), pkt->getSize());
+    }
 }
 
 bool
@@ -503,6 +526,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    invalidateBlocks(req->getPaddr(), req->getSize());
                 }
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
@@ -590,6 +614,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateBlocks(req->getPaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -607,12 +632,148 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
     return fault;
 }
 
+const InstBlockCache::Inst *
+AtomicSimpleCPU::nextCachedInst()
+{
+    if (!curBlock)
+        return nullptr;
+
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    if (blockCache->generation() == blockCacheGen &&
+            curBlockIdx < curBlock->insts.size() &&
+            thread->decoder->decodeMode() == curBlock->decodeMode) {
+        const InstBlockCache::Inst &inst = curBlock->insts[curBlockIdx];
+        if (*inst.fetchPC == thread->pcState()) {
+            curBlockIdx++;
+            blockCache->stats.cachedInsts++;
+            return &inst;
+        }
+    }
+
+    // Left the block, fetch and decode from scratch again
+    curBlock = nullptr;
+    thread->decoder->reset();
+    return nullptr;
+}
+
+const InstBlockCache::Inst *
+AtomicSimpleCPU::fetchCachedBlock()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    Addr paddr = ifetch_req->getPaddr();
+
+    if (newBlock) {
+        // Blocks end at page boundaries so that writes to a page only
+        // have to drop the blocks on that page.
+        if (blockCache->generation() == blockCacheGen &&
+                paddr / InstBlockCache::PageBytes ==
+                newBlock->paddr / InstBlockCache::PageBytes) {
+            return nullptr;
+        }
+        endBlock();
+    }
+
+    // Blocks start at instruction boundaries only
+    if (t_info.fetchOffset != 0)
+        return nullptr;
+
+    uint64_t decode_mode = thread->decoder->decodeMode();
+    blockCacheGen = blockCache->generation();
+    curBlock = blockCache->lookup(paddr, decode_mode, thread->pcState());
+    curBlockIdx = 0;
+    if (curBlock)
+        return nextCachedInst();
+
+    newBlock = std::make_unique<InstBlockCache::Block>(paddr, decode_mode);
+    return nullptr;
+}
+
+void
+AtomicSimpleCPU::recordInst(std::unique_ptr<PCStateBase> fetch_pc)
+{
+    const StaticInstPtr &inst =
+        curMacroStaticInst ? curMacroStaticInst : curStaticInst;
+    if (!inst)
+        return;
+
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    newBlock->insts.push_back({std::move(fetch_pc),
+            std::unique_ptr<PCStateBase>(thread->pcState().clone()), inst});
+
+    if (InstBlockCache::endsBlock(inst) ||
+            newBlock->insts.size() >= blockCache->maxBlockInsts()) {
+        endBlock();
+    }
+}
+
+void
+AtomicSimpleCPU::endBlock()
+{
+    if (newBlock && !newBlock->insts.empty() &&
+            blockCache->generation() == blockCacheGen) {
+        blockCache->insert(std::move(newBlock));
+    }
+    newBlock.reset();
+
+    if (curBlock) {
+        curBlock = nullptr;
+        threadInfo[curThread]->thread->decoder->reset();
+    }
+}
+
+void
+AtomicSimpleCPU::recordCodePage()
+{
+    const Addr page = ifetch_req->getVaddr() & ~(CodePageBytes - 1);
+    const Addr ppage = ifetch_req->getPaddr() & ~(CodePageBytes - 1);
+    if (page == lastCodePage && ppage == lastCodePPage &&
+            curThread == lastCodeThread) {
+        return;
+    }
+    lastCodePage = page;
+    lastCodePPage = ppage;
+    lastCodeThread = curThread;
+
+    auto &pages = codePages[ppage];
+    const std::pair<ThreadID, Addr> code_page(curThread, page);
+    if (std::find(pages.begin(), pages.end(), code_page) == pages.end())
+        pages.push_back(code_page);
+}
+
+void
+AtomicSimpleCPU::invalidateBlocks(Addr paddr, Addr size)
+{
+    if (blockCache)
+        blockCache->invalidate(paddr, size);
+
+    if (codePages.empty())
+        return;
+
+    const Addr last = (paddr + size - 1) & ~(CodePageBytes - 1);
+    for (Addr ppage = paddr & ~(CodePageBytes - 1); ppage <= last;
+            ppage += CodePageBytes) {
+        auto it = codePages.find(ppage);
+        if (it == codePages.end())
+            continue;
+        for (const auto &code_page : it->second) {
+            threadInfo[code_page.first]->thread->decoder->invalidateCode(
+                code_page.second);
+        }
+        // the next fetch from the page records it again
+        codePages.erase(it);
+        lastCodePPage = MaxAddr;
+    }
+}
+
 void
 AtomicSimpleCPU::tick()
 {
     DPRINTF(SimpleCPU, "Tick\n");
 
     // Change thread if multi-threaded
+    if (numThreads > 1 && blockCache)
+        endBlock();
     swapActiveThread();
 
     // Set memory request ids to current thread
@@ -630,7 +791,8 @@ AtomicSimpleCPU::tick()
 
     Tick latency = 0;
 
-    for (int i = 0; i < width || locked; ++i) {
+    int i = 0;
+    for (; i < width || locked || inCachedBlock(); ++i) {
         baseStats.numCycles++;
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -652,11 +814,22 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+        const InstBlockCache::Inst *cached_inst = nullptr;
+        if (needToFetch && blockCache) {
+            cached_inst = nextCachedInst();
+            needToFetch = !cached_inst;
+        }
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseMMU::Execute);
+            if (fault == NoFault)
+                recordCodePage();
+            if (fault == NoFault && blockCache) {
+                cached_inst = fetchCachedBlock();
+                needToFetch = !cached_inst;
+            }
         }
 
         if (fault == NoFault) {
@@ -677,7 +850,16 @@ AtomicSimpleCPU::tick()
                 //}
             }
 
-            preExecute();
+            if (cached_inst) {
+                preExecute(cached_inst->staticInst, *cached_inst->decodedPC);
+            } else if (needToFetch && newBlock) {
+                std::unique_ptr<PCStateBase> fetch_pc(pc.clone());
+                preExecute();
+                if (!t_info.stayAtPC)
+                    recordInst(std::move(fetch_pc));
+            } else {
+                preExecute();
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -725,6 +907,8 @@ AtomicSimpleCPU::tick()
         }
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
+        if (fault != NoFault && blockCache)
+            endBlock();
     }
 
     if (tryCompleteDrain())
@@ -734,6 +918,10 @@ AtomicSimpleCPU::tick()
     if (latency < clockPeriod())
         latency = clockPeriod();
 
+    // a block run in one go takes as long as the ticks it replaces
+    if (blockCache)
+        latency = std::max<Tick>(latency, divCeil(i, width) * clockPeriod());
+
     if (_status != Idle)
         reschedule(tickEvent, curTick() + latency, true);
 }
@@ -41,8 +41,14 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
+#include "cpu/simple/inst_block_cache.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -70,6 +76,72 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     // main simulation loop (one cycle)
     void tick();
 
+    /**
+     * Decoded basic blocks for block execution mode, nullptr if the mode
+     * is off. In this mode the CPU records the instructions it decodes
+     * into blocks and, when it reaches the start of a recorded block
+     * again, runs the whole block in one tick without fetching or
+     * decoding. Every instruction is still executed, counted and probed
+     * individually, and interrupts and PC events are checked between
+     * instructions as usual.
+     */
+    std::unique_ptr<InstBlockCache> blockCache;
+    /** Block being run and the index of its next instruction. */
+    const InstBlockCache::Block *curBlock = nullptr;
+    size_t curBlockIdx = 0;
+    /** Block being recorded from regular fetches. */
+    std::unique_ptr<InstBlockCache::Block> newBlock;
+    /** Cache generation curBlock and newBlock belong to. */
+    uint64_t blockCacheGen = 0;
+
+    bool
+    inCachedBlock() const
+    {
+        return curBlock && blockCache->generation() == blockCacheGen &&
+            curBlockIdx < curBlock->insts.size();
+    }
+
+    /** Next instruction of the current block if the PC still follows it. */
+    const InstBlockCache::Inst *nextCachedInst();
+    /**
+     * Called after translating a regular fetch. Continues the recording
+     * of a block, or looks up a block at the fetch address and returns
+     * its first instruction, or starts recording a new block.
+     */
+    const InstBlockCache::Inst *fetchCachedBlock();
+    /** Add the instruction just decoded to the block being recorded. */
+    void recordInst(std::unique_ptr<PCStateBase> fetch_pc);
+    /** Stop running or recording a block. */
+    void endBlock();
+
+    /** Granularity at which the decoders cache instructions by PC. */
+    static constexpr Addr CodePageBytes = 4096;
+
+    /**
+     * Pages of the fetch PCs the decoders cached instructions for, by
+     * the physical page the code was fetched from. Stores only know the
+     * physical address of the code they modify, while the decoders
+     * index their caches by PC, which may map the same code more than
+     * once.
+     */
+    std::unordered_map<Addr, std::vector<std::pair<ThreadID, Addr>>>
+        codePages;
+    /** Pages of the last fetch recorded, to record a mapping once. */
+    Addr lastCodePage = MaxAddr;
+    Addr lastCodePPage = MaxAddr;
+    ThreadID lastCodeThread = InvalidThreadID;
+
+    /** Record the pages of the fetch just translated in codePages. */
+    void recordCodePage();
+
+    /**
+     * Drop cached blocks and decoded instructions on code that was
+     * written to. The decode caches check the machine code they are
+     * handed anyway, but there is no point in keeping instructions
+     * around that were overwritten.
+     */
+    void invalidateBlocks(Addr paddr, Addr size);
+
     /**
      * Check if a system is in a drained state.
      *
@@ -181,6 +253,13 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Return a reference to the instruction port. */
     Port &getInstPort() override { return icachePort; }
 
+    /** Drop the blocks on code written by system call emulation. */
+    void
+    functionalWrite(Addr paddr, Addr size) override
+    {
+        invalidateBlocks(paddr, size);
+    }
+
     /** Perform snoop for other cpu-local thread contexts. */
     void threadSnoop(PacketPtr pkt, ThreadID sender);
 
@@ -132,11 +132,26 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Bookkeeping for the instruction that was just decoded: tracing,
+     * branch prediction and fetch statistics.
+     */
+    void postDecode();
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
     void serviceInstCountEvents();
     void preExecute();
+    /**
+     * Prepare to execute an instruction decoded by an earlier fetch
+     * from the current PC, without fetching or decoding it again.
+     *
+     * @param inst The decoded (macro)instruction.
+     * @param decoded_pc The PC as the decoder left it.
+     */
+    void preExecute(const StaticInstPtr &inst,
+                    const PCStateBase &decoded_pc);
     void postExecute();
     void advancePC(const Fault &fault);
 
@@ -0,0 +1,142 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/inst_block_cache.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Blocks kept per start address, for different entry PCs and modes. */
+constexpr size_t MaxVariants = 4;
+
+} // anonymous namespace
+
+InstBlockCache::InstBlockCache(statistics::Group *parent, size_t max_blocks,
+                               size_t max_block_insts)
+    : stats(parent), maxBlocks(max_blocks), _maxBlockInsts(max_block_insts)
+{
+}
+
+const InstBlockCache::Block *
+InstBlockCache::lookup(Addr paddr, uint64_t decode_mode,
+                       const PCStateBase &pc)
+{
+    stats.lookups++;
+    auto it = blocks.find(paddr);
+    if (it == blocks.end())
+        return nullptr;
+
+    for (const auto &block : it->second) {
+        if (block->decodeMode == decode_mode &&
+                *block->insts.front().fetchPC == pc) {
+            stats.hits++;
+            return block.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+InstBlockCache::insert(std::unique_ptr<Block> block)
+{
+    assert(!block->insts.empty());
+
+    if (numBlocks >= maxBlocks)
+        flush();
+
+    Addr paddr = block->paddr;
+    auto &variants = blocks[paddr];
+    if (variants.empty()) {
+        pageBlocks[paddr / PageBytes].push_back(paddr);
+    } else if (variants.size() >= MaxVariants) {
+        variants.erase(variants.begin());
+        numBlocks--;
+    }
+    variants.push_back(std::move(block));
+    numBlocks++;
+    stats.blocksBuilt++;
+}
+
+bool
+InstBlockCache::invalidatePages(Addr paddr, Addr size)
+{
+    bool dropped = false;
+    Addr first = paddr / PageBytes;
+    Addr last = (paddr + std::max<Addr>(size, 1) - 1) / PageBytes;
+    for (Addr page = first; page <= last; page++) {
+        auto it = pageBlocks.find(page);
+        if (it == pageBlocks.end())
+            continue;
+
+        for (Addr start : it->second) {
+            auto block_it = blocks.find(start);
+            numBlocks -= block_it->second.size();
+            blocks.erase(block_it);
+        }
+        pageBlocks.erase(it);
+        _generation++;
+        stats.invalidations++;
+        dropped = true;
+    }
+    return dropped;
+}
+
+void
+InstBlockCache::flush()
+{
+    blocks.clear();
+    pageBlocks.clear();
+    numBlocks = 0;
+    _generation++;
+    stats.flushes++;
+}
+
+InstBlockCache::InstBlockCacheStats::InstBlockCacheStats(
+        statistics::Group *parent)
+    : statistics::Group(parent, "blockCache"),
+      ADD_STAT(blocksBuilt, statistics::units::Count::get(),
+               "Number of blocks recorded into the cache"),
+      ADD_STAT(lookups, statistics::units::Count::get(),
+               "Number of lookups at the start of a block"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of lookups that found a block"),
+      ADD_STAT(cachedInsts, statistics::units::Count::get(),
+               "Number of instructions run without fetching and decoding"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of pages whose blocks were dropped by writes"),
+      ADD_STAT(flushes, statistics::units::Count::get(),
+               "Number of times the whole cache was dropped"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of block lookups that hit", hits / lookups)
+{
+    hitRate.precision(6);
+}
+
+} // namespace gem5
@@ -0,0 +1,158 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+/**
+ * A cache of decoded basic blocks for the atomic CPU's block execution
+ * mode. A block holds the instructions decoded from consecutive fetches
+ * on one physical page. For each instruction it keeps the PC it was
+ * fetched at and the PC the decoder left behind, so that a CPU whose PC
+ * matches the recorded one can skip fetching and decoding it.
+ *
+ * Blocks are looked up by the physical address of their first
+ * instruction and the decoder mode. Several blocks may start at the same
+ * address if they were entered with different PCs, e.g., with a
+ * different next PC on variable length ISAs. Writes to a page drop all
+ * blocks on it.
+ */
+class InstBlockCache
+{
+  public:
+    struct Inst
+    {
+        /** PC the instruction was fetched at. */
+        std::unique_ptr<PCStateBase> fetchPC;
+        /** PC as updated by the decoder. */
+        std::unique_ptr<PCStateBase> decodedPC;
+        /** The decoded instruction, a macroop for microcoded ones. */
+        StaticInstPtr staticInst;
+    };
+
+    struct Block
+    {
+        Block(Addr _paddr, uint64_t decode_mode)
+            : paddr(_paddr), decodeMode(decode_mode)
+        {}
+
+        const Addr paddr;
+        const uint64_t decodeMode;
+        std::vector<Inst> insts;
+    };
+
+    /** Granularity of code invalidation. */
+    static constexpr Addr PageBytes = 4096;
+
+    InstBlockCache(statistics::Group *parent, size_t max_blocks,
+                   size_t max_block_insts);
+
+    /**
+     * Find a block starting at a physical address.
+     *
+     * @param paddr Physical address of the first instruction.
+     * @param decode_mode Mode of the decoder (InstDecoder::decodeMode()).
+     * @param pc PC the first instruction is about to be fetched at.
+     * @return The block, or nullptr if there is none.
+     */
+    const Block *lookup(Addr paddr, uint64_t decode_mode,
+                        const PCStateBase &pc);
+
+    /** Add a block recorded from regular fetches. */
+    void insert(std::unique_ptr<Block> block);
+
+    /**
+     * Drop all blocks on the pages a write touches.
+     *
+     * @return Whether any blocks were dropped.
+     */
+    bool
+    invalidate(Addr paddr, Addr size)
+    {
+        return !pageBlocks.empty() && invalidatePages(paddr, size);
+    }
+
+    /** Drop all blocks. */
+    void flush();
+
+    /**
+     * Incremented whenever blocks are dropped. Blocks a CPU holds on to
+     * are only valid while the generation does not change.
+     */
+    uint64_t generation() const { return _generation; }
+
+    size_t maxBlockInsts() const { return _maxBlockInsts; }
+
+    /** Whether a block must end after an instruction. */
+    static bool
+    endsBlock(const StaticInstPtr &inst)
+    {
+        return inst->isControl() || inst->isNonSpeculative() ||
+            inst->isSerializeAfter() || inst->isSquashAfter() ||
+            inst->isSyscall() || inst->isQuiesce();
+    }
+
+    struct InstBlockCacheStats : public statistics::Group
+    {
+        InstBlockCacheStats(statistics::Group *parent);
+
+        statistics::Scalar blocksBuilt;
+        statistics::Scalar lookups;
+        statistics::Scalar hits;
+        statistics::Scalar cachedInsts;
+        statistics::Scalar invalidations;
+        statistics::Scalar flushes;
+        statistics::Formula hitRate;
+    } stats;
+
+  private:
+    bool invalidatePages(Addr paddr, Addr size);
+
+    const size_t maxBlocks;
+    const size_t _maxBlockInsts;
+    size_t numBlocks = 0;
+    uint64_t _generation = 0;
+
+    /** Blocks by the physical address of their first instruction. */
+    std::unordered_map<Addr, std::vector<std::unique_ptr<Block>>> blocks;
+    /** Start addresses of the blocks on each page. */
+    std::unordered_map<Addr, std::vector<Addr>> pageBlocks;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_INST_BLOCK_CACHE_HH__
@@ -37,22 +37,97 @@
 
 #include "cpu/simple/noncaching.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <mutex>
 
 #include "arch/generic/decoder.hh"
+#include "mem/physical.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
 
+namespace
+{
+
+/**
+ * Orders the stores, atomics and locked read-modify-writes of CPUs
+ * that share memory through backdoors from different host threads.
+ * Every cache line maps to a stripe with a spin lock and a version,
+ * bumped by each store, that stands in for the load-locked tracking of
+ * the memory.
+ */
+struct alignas(64) Stripe
+{
+    std::atomic<bool> busy{false};
+    std::atomic<uint64_t> version{0};
+
+    void
+    lock()
+    {
+        while (busy.exchange(true, std::memory_order_acquire)) {
+            while (busy.load(std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    void unlock() { busy.store(false, std::memory_order_release); }
+};
+
+constexpr unsigned NumStripes = 4096;
+Stripe stripes[NumStripes];
+
+/**
+ * Taken for the whole of a locked read-modify-write, which may hold
+ * the stripes of two cache lines. Only one CPU can thus wait for a
+ * stripe while holding another.
+ */
+std::mutex lockedRMWMutex;
+
+} // anonymous namespace
+
 NonCachingSimpleCPU::NonCachingSimpleCPU(
         const BaseNonCachingSimpleCPUParams &p)
-    : AtomicSimpleCPU(p)
+    : AtomicSimpleCPU(p), parallel(false),
+      llscStripe(0), llscVersion(0), llscValid(false)
 {
     assert(p.numThreads == 1);
     fatal_if(!FullSystem && p.workload.size() != 1,
              "only one workload allowed");
 }
 
+void
+NonCachingSimpleCPU::init()
+{
+    AtomicSimpleCPU::init();
+
+    parallel = eventQueue() != system->eventQueue();
+    if (!parallel)
+        return;
+
+    // Stores by the other CPUs bypass this CPU entirely and would not
+    // invalidate the blocks it has cached.
+    fatal_if(blockCache, "%s: block_execution is not supported when "
+             "running on another event queue than the system.", name());
+
+    // Going through the memory system from another event queue is
+    // expensive, so get the backdoors to memory before starting.
+    const auto flags = (MemBackdoor::Flags)(
+            MemBackdoor::Readable | MemBackdoor::Writeable);
+    for (const auto &range : system->getPhysMem().getConfAddrRanges()) {
+        MemBackdoorPtr bd = nullptr;
+        dcachePort.sendMemBackdoorReq(MemBackdoorReq(range, flags), bd);
+        if (bd)
+            addBackdoor(bd);
+        else
+            warn("%s: No backdoor to %s, accesses will be slow.",
+                 name(), range.to_string());
+    }
+}
+
 void
 NonCachingSimpleCPU::verifyMemoryMode() const
 {
@@ -62,15 +137,10 @@ NonCachingSimpleCPU::verifyMemoryMode() const
     }
 }
 
-Tick
-NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
+void
+NonCachingSimpleCPU::addBackdoor(MemBackdoorPtr bd)
 {
-    MemBackdoorPtr bd = nullptr;
-    Tick latency = port.sendAtomicBackdoor(pkt, bd);
-
-    // If the target gave us a backdoor for next time and we didn't
-    // already have it, record it.
-    if (bd && memBackdoors.insert(bd->range(), bd) != memBackdoors.end()) {
+    if (memBackdoors.insert(bd->range(), bd) != memBackdoors.end()) {
         // Install a callback to erase this backdoor if it goes away.
         auto callback = [this](const MemBackdoor &backdoor) {
                 for (auto it = memBackdoors.begin();
@@ -84,9 +154,147 @@ NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
             };
         bd->addInvalidationCallback(callback);
     }
+}
+
+Tick
+NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
+{
+    if (parallel) {
+        auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+        if (bd_it != memBackdoors.end() && bd_it->second->readable() &&
+                bd_it->second->writeable()) {
+            return accessBackdoor(*bd_it->second, pkt);
+        }
+
+        // Devices and the like are only safe to use from the event
+        // queue they live on.
+        EventQueue::ScopedMigration migrate(system->eventQueue());
+        return port.sendAtomic(pkt);
+    }
+
+    MemBackdoorPtr bd = nullptr;
+    Tick latency = port.sendAtomicBackdoor(pkt, bd);
+
+    // If the target gave us a backdoor for next time and we didn't
+    // already have it, record it.
+    if (bd)
+        addBackdoor(bd);
     return latency;
 }
 
+Tick
+NonCachingSimpleCPU::accessBackdoor(const MemBackdoor &bd, PacketPtr pkt)
+{
+    const AddrRange &range = bd.range();
+    uint8_t *host_addr = bd.ptr() +
+        (range.removeIntlvBits(pkt->getAddr()) - range.start());
+    const RequestPtr &req = pkt->req;
+    const unsigned s = (pkt->getAddr() / cacheLineSize()) % NumStripes;
+    Stripe &stripe = stripes[s];
+
+    if (pkt->isRead() && !pkt->isWrite()) {
+        if (req->isLockedRMW()) {
+            // Held until the matching write, see writeMem().
+            if (lockedStripes.empty())
+                lockedRMWMutex.lock();
+            if (!holdsStripe(s)) {
+                stripe.lock();
+                lockedStripes.push_back(s);
+            }
+        }
+        if (req->isLLSC()) {
+            llscStripe = s;
+            llscVersion = stripe.version.load(std::memory_order_acquire);
+            llscValid = true;
+        }
+        pkt->setData(host_addr);
+    } else if (pkt->isWrite()) {
+        const bool held = holdsStripe(s);
+        if (!held)
+            stripe.lock();
+
+        bool do_write = true;
+        if (req->isLLSC()) {
+            do_write = llscValid && llscStripe == s &&
+                stripe.version.load(std::memory_order_relaxed) ==
+                llscVersion;
+            req->setExtraData(do_write ? 1 : 0);
+            llscValid = false;
+        }
+
+        if (pkt->cmd == MemCmd::SwapReq && pkt->isAtomicOp()) {
+            pkt->setData(host_addr);
+            (*(pkt->getAtomicOp()))(host_addr);
+        } else if (pkt->cmd == MemCmd::SwapReq) {
+            std::vector<uint8_t> new_val(pkt->getSize());
+            pkt->writeData(new_val.data());
+            pkt->setData(host_addr);
+            if (req->isCondSwap()) {
+                panic_if(pkt->getSize() != sizeof(uint64_t) &&
+                         pkt->getSize() != sizeof(uint32_t),
+                         "Invalid size for conditional read/write\n");
+                const uint64_t cond = req->getExtraData();
+                do_write = !std::memcmp(&cond, host_addr, pkt->getSize());
+            }
+            if (do_write)
+                std::memcpy(host_addr, new_val.data(), pkt->getSize());
+        } else if (do_write) {
+            pkt->writeData(host_addr);
+        }
+
+        if (do_write)
+            stripe.version.fetch_add(1, std::memory_order_release);
+        if (!held)
+            stripe.unlock();
+    }
+    // Cache maintenance has nothing to do without caches.
+
+    if (pkt->needsResponse())
+        pkt->makeResponse();
+    return 0;
+}
+
+bool
+NonCachingSimpleCPU::holdsStripe(unsigned stripe) const
+{
+    return std::find(lockedStripes.begin(), lockedStripes.end(),
+                     stripe) != lockedStripes.end();
+}
+
+void
+NonCachingSimpleCPU::releaseLockedStripes()
+{
+    for (unsigned s : lockedStripes)
+        stripes[s].unlock();
+    lockedStripes.clear();
+    lockedRMWMutex.unlock();
+}
+
+Fault
+NonCachingSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
+                             Request::Flags flags,
+                             const std::vector<bool> &byte_enable)
+{
+    Fault fault = AtomicSimpleCPU::readMem(addr, data, size, flags,
+                                           byte_enable);
+    // A locked read that faulted won't be followed by its write.
+    if (fault != NoFault && !lockedStripes.empty())
+        releaseLockedStripes();
+    return fault;
+}
+
+Fault
+NonCachingSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
+                              Request::Flags flags, uint64_t *res,
+                              const std::vector<bool> &byte_enable)
+{
+    Fault fault = AtomicSimpleCPU::writeMem(data, size, addr, flags, res,
+                                            byte_enable);
+    if (!lockedStripes.empty() && (fault != NoFault || !locked))
+        releaseLockedStripes();
+    return fault;
+}
+
 Tick
 NonCachingSimpleCPU::fetchInstMem()
 {
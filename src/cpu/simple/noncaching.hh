@@ -38,6 +38,8 @@
 #ifndef __CPU_SIMPLE_NONCACHING_HH__
 #define __CPU_SIMPLE_NONCACHING_HH__
 
+#include <vector>
+
 #include "base/addr_range_map.hh"
 #include "cpu/simple/atomic.hh"
 #include "mem/backdoor.hh"
@@ -49,17 +51,60 @@ namespace gem5
 /**
  * The NonCachingSimpleCPU is an AtomicSimpleCPU using the
  * 'atomic_noncaching' memory mode instead of just 'atomic'.
+ *
+ * The CPU can run on its own event queue, and thus host thread, to
+ * fast-forward multi-core systems in parallel. It then accesses memory
+ * through backdoors, which it requests up front, and only goes through
+ * the memory system, on the system's event queue, for anything else.
+ * Stores, atomics and locked accesses to memory are ordered between
+ * the CPUs by locks on the cache lines they touch.
+ *
+ * Only the stores of these CPUs break a load-locked reservation. DMA
+ * and device writes go through the memory system and do not, so a
+ * store-conditional may succeed over them. Block execution is not
+ * supported in this mode.
  */
 class NonCachingSimpleCPU : public AtomicSimpleCPU
 {
   public:
     NonCachingSimpleCPU(const BaseNonCachingSimpleCPUParams &p);
 
+    void init() override;
+
     void verifyMemoryMode() const override;
 
+    Fault readMem(Addr addr, uint8_t *data, unsigned size,
+                  Request::Flags flags,
+                  const std::vector<bool> &byte_enable=std::vector<bool>())
+        override;
+
+    Fault writeMem(uint8_t *data, unsigned size,
+                   Addr addr, Request::Flags flags, uint64_t *res,
+                   const std::vector<bool> &byte_enable=std::vector<bool>())
+        override;
+
   protected:
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
+    /** Whether the CPU runs on another event queue than the system. */
+    bool parallel;
+
+    /** Stripes held by the ongoing locked read-modify-write, if any. */
+    std::vector<unsigned> lockedStripes;
+
+    /** Stripe and its version at the last load-locked. */
+    unsigned llscStripe;
+    uint64_t llscVersion;
+    bool llscValid;
+
+    void addBackdoor(MemBackdoorPtr bd);
+
+    /** Access memory directly while running in parallel. */
+    Tick accessBackdoor(const MemBackdoor &bd, PacketPtr pkt);
+
+    bool holdsStripe(unsigned stripe) const;
+    void releaseLockedStripes();
+
     Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
     Tick fetchInstMem() override;
 };
@@ -129,6 +129,9 @@ void
 GarnetSyntheticTraffic::init()
 {
     numPacketsSent = 0;
+
+    if (numMainEventQueues > 1)
+        privateRng.reset(new Random(random_mt.random<uint32_t>()));
 }
 
 
@@ -159,7 +162,7 @@ GarnetSyntheticTraffic::tick()
     // - send pkt if this number is < injRate*(10^precision)
     bool sendAllowedThisCycle;
     double injRange = pow((double) 10, (double) precision);
-    unsigned trySending = random_mt.random<unsigned>(0, (int) injRange);
+    unsigned trySending = rng().random<unsigned>(0, (int) injRange);
     if (trySending < injRate*injRange)
         sendAllowedThisCycle = true;
     else
@@ -206,7 +209,7 @@ GarnetSyntheticTraffic::generatePkt()
     {
         destination = singleDest;
     } else if (traffic == UNIFORM_RANDOM_) {
-        destination = random_mt.random<unsigned>(0, num_destinations - 1);
+        destination = rng().random<unsigned>(0, num_destinations - 1);
     } else if (traffic == BIT_COMPLEMENT_) {
         dest_x = radix - src_x - 1;
         dest_y = radix - src_y - 1;
@@ -249,7 +252,7 @@ GarnetSyntheticTraffic::generatePkt()
     } else if (traffic == DRAGONFLY_WC_) {
         assert(num_groups != -1 && numDestPerGroup != -1);
         destination = (source / nodes_per_group + 1) * nodes_per_group
-                    + random_mt.random<unsigned>(0, nodes_per_group - 1);
+                    + rng().random<unsigned>(0, nodes_per_group - 1);
     }
     else {
         fatal("Unknown Traffic Type: %s!\n", traffic);
@@ -299,7 +302,7 @@ GarnetSyntheticTraffic::generatePkt()
     if (injReqType < 0 || injReqType > 2)
     {
         // randomly inject in any vnet
-        injReqType = random_mt.random(0, 2);
+        injReqType = rng().random(0, 2);
     }
 
     if (injReqType == 0) {
@@ -29,8 +29,10 @@
 #ifndef __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 #define __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 
+#include <memory>
 #include <set>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/GarnetSyntheticTraffic.hh"
@@ -138,6 +140,12 @@ class GarnetSyntheticTraffic : public ClockedObject
 
     RequestorID requestorId;
 
+    // Testers may tick concurrently when the system runs on several event
+    // queues. They then draw from a private generator instead of the
+    // global one.
+    std::unique_ptr<Random> privateRng;
+    Random &rng() { return privateRng ? *privateRng : random_mt; }
+
     void completeRequest(PacketPtr pkt);
 
     void generatePkt();
@@ -157,10 +157,12 @@ ThreadContext::compare(ThreadContext *one, ThreadContext *two)
 void
 ThreadContext::sendFunctional(PacketPtr pkt)
 {
-    const auto *port =
-        dynamic_cast<const RequestPort *>(&getCpuPtr()->getDataPort());
+    BaseCPU *cpu = getCpuPtr();
+    const auto *port = dynamic_cast<const RequestPort *>(&cpu->getDataPort());
     assert(port);
     port->sendFunctional(pkt);
+    if (pkt->isWrite())
+        cpu->functionalWrite(pkt->getAddr(), pkt->getSize());
 }
 
 void
@@ -77,6 +77,13 @@ class TraceCPU(BaseCPU):
         1.0, "Multiplier scale the Trace CPU frequency up or down"
     )
 
+    # Number of data dependency trace records decoded ahead of the replay in
+    # a separate thread. A value of 0 decodes records when the replay needs
+    # them.
+    dataTracePrefetch = Param.Unsigned(
+        0, "Data dependency trace records to decode ahead in a thread"
+    )
+
     # Enable exiting when any one Trace CPU completes execution which is set to
     # false by default
     enableEarlyExit = Param.Bool(
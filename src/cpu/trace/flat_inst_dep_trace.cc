@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/flat_inst_dep_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+FlatInstDepTrace::FlatInstDepTrace(const std::string &_filename)
+    : filename(_filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Failed to open trace %s: %s", filename,
+             strerror(errno));
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) < 0, "Failed to stat trace %s: %s", filename,
+             strerror(errno));
+    mapSize = st.st_size;
+    fatal_if(mapSize < RecordsOffset, "Trace %s is truncated", filename);
+
+    map = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    fatal_if(map == MAP_FAILED, "Failed to map trace %s: %s", filename,
+             strerror(errno));
+    // The trace is replayed front to back.
+    madvise(map, mapSize, MADV_SEQUENTIAL);
+
+    const char *base = static_cast<const char *>(map);
+    header = reinterpret_cast<const Header *>(base);
+    fatal_if(memcmp(header->magic, Magic, sizeof(Magic)) != 0,
+             "%s is not a flat instruction dependency trace", filename);
+    fatal_if(header->recordSize != sizeof(Record),
+             "Trace %s has %d byte records, expected %d", filename,
+             header->recordSize, sizeof(Record));
+    fatal_if(header->numRecords > mapSize / sizeof(Record) ||
+             header->numDeps > mapSize / sizeof(uint64_t) ||
+             header->depsOffset > mapSize ||
+             RecordsOffset + header->numRecords * sizeof(Record) >
+             header->depsOffset ||
+             header->depsOffset + header->numDeps * sizeof(uint64_t) >
+             mapSize, "Trace %s is truncated", filename);
+
+    records = reinterpret_cast<const Record *>(base + RecordsOffset);
+    _deps = reinterpret_cast<const uint64_t *>(base + header->depsOffset);
+
+    // deps() trusts the records, so check them all up front
+    for (uint64_t i = 0; i < header->numRecords; ++i) {
+        const Record &rec = records[i];
+        const uint64_t num_deps = rec.numRobDeps + rec.numRegDeps;
+        fatal_if(rec.depIdx > header->numDeps ||
+                 num_deps > header->numDeps - rec.depIdx,
+                 "Record %d of trace %s has dependencies out of bounds",
+                 i, filename);
+    }
+}
+
+FlatInstDepTrace::~FlatInstDepTrace()
+{
+    munmap(map, mapSize);
+}
+
+bool
+FlatInstDepTrace::isFlat(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(Magic)];
+    if (!file.read(magic, sizeof(magic)))
+        return false;
+    return memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+} // namespace gem5
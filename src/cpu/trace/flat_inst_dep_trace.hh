@@ -0,0 +1,127 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TRACE_FLAT_INST_DEP_TRACE_HH__
+#define __CPU_TRACE_FLAT_INST_DEP_TRACE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+/**
+ * An uncompressed instruction dependency (elastic) trace that is mapped
+ * into memory instead of being parsed.
+ *
+ * The file starts with a Header, padded to RecordsOffset bytes, and is
+ * followed by one fixed-size Record per instruction, so record i can be
+ * found without reading the ones before it. The dependencies of all
+ * records are stored after the records, each record pointing at its
+ * order dependencies followed by its register dependencies. All fields
+ * are little endian.
+ *
+ * Flat traces are created from the protobuf traces written by the
+ * elastic trace probe using util/flatten_inst_dep_trace.py.
+ */
+class FlatInstDepTrace
+{
+  public:
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'E', 'D', 'T', '1'};
+    static constexpr size_t RecordsOffset = 64;
+
+    struct Header
+    {
+        char magic[8];
+        uint64_t tickFreq;
+        uint32_t windowSize;
+        uint32_t recordSize;
+        uint64_t numRecords;
+        uint64_t numDeps;
+        /** Offset of the dependency array from the start of the file. */
+        uint64_t depsOffset;
+    };
+
+    struct Record
+    {
+        uint64_t seqNum;
+        uint64_t physAddr;
+        uint64_t virtAddr;
+        uint64_t pc;
+        uint64_t compDelay;
+        /** Index of the first dependency in the dependency array. */
+        uint64_t depIdx;
+        uint32_t size;
+        uint32_t flags;
+        uint32_t weight;
+        uint16_t numRobDeps;
+        uint8_t numRegDeps;
+        /** An InstDepRecord::RecordType. */
+        uint8_t type;
+    };
+
+    static_assert(sizeof(Header) <= RecordsOffset);
+    static_assert(sizeof(Record) == 64);
+
+    /**
+     * Map a flat trace, failing if it is malformed.
+     *
+     * @param filename Path to the trace
+     */
+    FlatInstDepTrace(const std::string &filename);
+    ~FlatInstDepTrace();
+
+    FlatInstDepTrace(const FlatInstDepTrace &) = delete;
+    FlatInstDepTrace &operator=(const FlatInstDepTrace &) = delete;
+
+    /** Check whether a file is a flat trace by looking at its magic. */
+    static bool isFlat(const std::string &filename);
+
+    uint64_t tickFreq() const { return header->tickFreq; }
+    uint32_t windowSize() const { return header->windowSize; }
+    uint64_t size() const { return header->numRecords; }
+
+    const Record &record(uint64_t idx) const { return records[idx]; }
+
+    /**
+     * The order dependencies of a record, then its register ones. The
+     * constructor checked that they lie within the dependency array.
+     */
+    const uint64_t *deps(const Record &rec) const { return &_deps[rec.depIdx]; }
+
+  private:
+    const std::string filename;
+    void *map = nullptr;
+    size_t mapSize = 0;
+
+    const Header *header = nullptr;
+    const Record *records = nullptr;
+    const uint64_t *_deps = nullptr;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRACE_FLAT_INST_DEP_TRACE_HH__
@@ -38,6 +38,7 @@
 #include "cpu/trace/trace_cpu.hh"
 
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "sim/sim_exit.hh"
 
 namespace gem5
@@ -311,13 +312,11 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
-
-        // Read the next line to get the next record. If that fails then end of
-        // trace has been reached and traceComplete needs to be set in addition
-        // to returning false.
-        if (!trace.read(new_node)) {
+        // Read the next line to get the next record as a new graph node. If
+        // that fails then end of trace has been reached and traceComplete
+        // needs to be set in addition to returning false.
+        GraphNode* new_node = trace.read();
+        if (!new_node) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
             return false;
@@ -1195,14 +1194,31 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
-    trace(filename),
+        const std::string& filename, const double time_multiplier,
+        size_t prefetch_nodes) :
+    flatIdx(0),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    prefetchBatches(divCeil(prefetch_nodes, BatchSize)),
+    prefetchDone(false),
+    prefetchStop(false),
+    curBatchIdx(0)
 {
+    if (FlatInstDepTrace::isFlat(filename)) {
+        flatTrace = std::make_unique<FlatInstDepTrace>(filename);
+        if (flatTrace->tickFreq() != sim_clock::Frequency) {
+            panic("Trace %s was recorded with a different tick frequency %d\n",
+                  filename, flatTrace->tickFreq());
+        }
+        windowSize = flatTrace->windowSize();
+        return;
+    }
+
+    protoTrace = std::make_unique<ProtoInputStream>(filename);
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!protoTrace->read(header_msg)) {
         panic("Failed to read packet header from %s\n", filename);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
@@ -1216,17 +1232,132 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
     }
 }
 
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stopPrefetch();
+}
+
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    stopPrefetch();
+    if (protoTrace)
+        protoTrace->reset();
+    flatIdx = 0;
+    microOpCount = 0;
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::startPrefetch()
+{
+    prefetchDone = false;
+    prefetchStop = false;
+    prefetcher = std::thread(&InputStream::prefetchLoop, this);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stopPrefetch()
+{
+    if (prefetcher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(prefetchMutex);
+            prefetchStop = true;
+        }
+        prefetchCond.notify_all();
+        prefetcher.join();
+    }
+
+    // Drop whatever was decoded but not replayed
+    for (auto &batch : prefetched) {
+        for (auto node : batch)
+            delete node;
+    }
+    prefetched.clear();
+    for (; curBatchIdx < curBatch.size(); curBatchIdx++)
+        delete curBatch[curBatchIdx];
+    curBatch.clear();
+    curBatchIdx = 0;
+    prefetchDone = false;
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::prefetchLoop()
+{
+    // Only touch the trace and the decoding state here, the rest of the
+    // simulator runs concurrently.
+    bool done = false;
+    while (!done) {
+        std::vector<GraphNode *> batch;
+        batch.reserve(BatchSize);
+        while (batch.size() < BatchSize) {
+            GraphNode *node = decode();
+            if (!node) {
+                done = true;
+                break;
+            }
+            batch.push_back(node);
+        }
+
+        std::unique_lock<std::mutex> lock(prefetchMutex);
+        prefetchCond.wait(lock, [this] {
+            return prefetchStop || prefetched.size() < prefetchBatches;
+        });
+        if (prefetchStop) {
+            for (auto node : batch)
+                delete node;
+            return;
+        }
+        if (!batch.empty())
+            prefetched.push_back(std::move(batch));
+        prefetchDone = done;
+        prefetchCond.notify_all();
+    }
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::read()
+{
+    if (prefetchBatches == 0)
+        return decode();
+
+    if (curBatchIdx == curBatch.size()) {
+        if (!prefetcher.joinable())
+            startPrefetch();
+
+        std::unique_lock<std::mutex> lock(prefetchMutex);
+        prefetchCond.wait(lock, [this] {
+            return !prefetched.empty() || prefetchDone;
+        });
+        if (prefetched.empty()) {
+            // We have reached the end of the file
+            return nullptr;
+        }
+        curBatch = std::move(prefetched.front());
+        prefetched.pop_front();
+        curBatchIdx = 0;
+        prefetchCond.notify_all();
+    }
+
+    return curBatch[curBatchIdx++];
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::decode()
+{
+    GraphNode *element = new GraphNode;
+    bool valid = flatTrace ? decodeFlat(element) : decodeProto(element);
+    if (!valid) {
+        delete element;
+        return nullptr;
+    }
+    return element;
 }
 
 bool
-TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+TraceCPU::ElasticDataGen::InputStream::decodeProto(GraphNode* element)
 {
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1292,6 +1423,48 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
     return false;
 }
 
+bool
+TraceCPU::ElasticDataGen::InputStream::decodeFlat(GraphNode* element)
+{
+    if (flatIdx == flatTrace->size()) {
+        // We have reached the end of the file
+        return false;
+    }
+
+    const FlatInstDepTrace::Record &rec = flatTrace->record(flatIdx++);
+    element->seqNum = rec.seqNum;
+    element->type = static_cast<RecordType>(rec.type);
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = rec.compDelay * timeMultiplier;
+
+    const uint64_t *deps = flatTrace->deps(rec);
+    element->robDep.assign(deps, deps + rec.numRobDeps);
+    deps += rec.numRobDeps;
+
+    // As for the protobuf trace, drop register dependencies that are also
+    // order dependencies
+    element->regDep.clear();
+    for (int i = 0; i < rec.numRegDeps; i++) {
+        bool duplicate = false;
+        for (auto &dep: element->robDep) {
+            duplicate |= (deps[i] == dep);
+        }
+        if (!duplicate)
+            element->regDep.push_back(deps[i]);
+    }
+
+    element->physAddr = rec.physAddr;
+    element->virtAddr = rec.virtAddr;
+    element->size = rec.size;
+    element->flags = rec.flags;
+    element->pc = rec.pc;
+
+    // ROB occupancy number
+    microOpCount += 1 + rec.weight;
+    element->robNum = microOpCount;
+    return true;
+}
+
 bool
 TraceCPU::ElasticDataGen::GraphNode::removeRegDep(NodeSeqNum reg_dep)
 {
@@ -38,14 +38,21 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/flat_inst_dep_trace.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -757,12 +764,23 @@ class TraceCPU : public BaseCPU
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
          * the input.
+         *
+         * The trace is either a protobuf trace or a flat trace that is
+         * mapped into memory. Either way, nodes can be decoded ahead of
+         * the replay in a separate thread, which hands them over in
+         * batches.
          */
         class InputStream
         {
           private:
-            /** Input file stream for the protobuf trace */
-            ProtoInputStream trace;
+            /** Input file stream for the protobuf trace, if used */
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            /** Mapped flat trace, if used */
+            std::unique_ptr<FlatInstDepTrace> flatTrace;
+
+            /** Index of the next record to decode in the flat trace */
+            uint64_t flatIdx;
 
             /**
              * A multiplier for the compute delays in the trace to modulate
@@ -772,7 +790,10 @@ class TraceCPU : public BaseCPU
              */
             const double timeMultiplier;
 
-            /** Count of committed ops read from trace plus the filtered ops */
+            /**
+             * Count of committed ops read from trace plus the filtered ops.
+             * Only the decoding thread touches it.
+             */
             uint64_t microOpCount;
 
             /**
@@ -781,15 +802,55 @@ class TraceCPU : public BaseCPU
              */
             uint32_t windowSize;
 
+            /** Number of nodes the prefetcher hands over at a time. */
+            static constexpr size_t BatchSize = 256;
+
+            /** Batches decoded ahead, or 0 to decode when asked to. */
+            const size_t prefetchBatches;
+
+            /** Thread decoding nodes ahead of the replay. */
+            std::thread prefetcher;
+
+            /** Protects the state shared with the prefetcher below. */
+            std::mutex prefetchMutex;
+            std::condition_variable prefetchCond;
+
+            /** Decoded batches ready to be replayed. */
+            std::deque<std::vector<GraphNode *>> prefetched;
+
+            /** Set when the prefetcher reached the end of the trace. */
+            bool prefetchDone;
+
+            /** Set to ask the prefetcher to stop. */
+            bool prefetchStop;
+
+            /** Batch the replay is taking nodes from. */
+            std::vector<GraphNode *> curBatch;
+            size_t curBatchIdx;
+
+            /** Decode the next node from the trace, if any. */
+            GraphNode *decode();
+            bool decodeProto(GraphNode *element);
+            bool decodeFlat(GraphNode *element);
+
+            void prefetchLoop();
+            void startPrefetch();
+            void stopPrefetch();
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param prefetch_nodes number of nodes to decode ahead in a
+             *                       separate thread, 0 to not prefetch
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        size_t prefetch_nodes);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -802,11 +863,10 @@ class TraceCPU : public BaseCPU
              * and also notify the caller if the end of the file
              * was reached.
              *
-             * @param element Trace element to populate
-             * @param size of register dependency array stored in the element
-             * @return True if an element could be read successfully
+             * @return A new node owned by the caller, or nullptr at the
+             *         end of the trace
              */
-            bool read(GraphNode* element);
+            GraphNode *read();
 
             /** Get window size from trace */
             uint32_t getWindowSize() const { return windowSize; }
@@ -824,7 +884,8 @@ class TraceCPU : public BaseCPU
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.dataTracePrefetch),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
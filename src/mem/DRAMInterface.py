@@ -70,6 +70,14 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Skip the refresh events of the ranks while the controller is idle,
+    # and account for the refreshes when the next request arrives. The
+    # stats are the same, but idle phases no longer cost any events. Only
+    # applies when powerdown is disabled.
+    defer_idle_refresh = Param.Bool(
+        False, "Defer refreshes while the controller is idle"
+    )
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
@@ -38,6 +38,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.SimObject import *
 from m5.params import *
 from m5.proxy import *
 from m5.objects.QoSMemCtrl import *
@@ -57,6 +58,8 @@ class MemCtrl(QoSMemCtrl):
     cxx_header = "mem/mem_ctrl.hh"
     cxx_class = "gem5::memory::MemCtrl"
 
+    cxx_exports = [PyBindMethod("setStatModel")]
+
     # single-ported on the system interface side, instantiate with a
     # bus in front of the controller for multiple ports
     port = ResponsePort("This port responds to memory requests")
@@ -66,6 +69,12 @@ class MemCtrl(QoSMemCtrl):
         "Memory interface, can be a DRAMor an NVM interface "
     )
 
+    # statistical model of the DRAM interface, e.g., for warming up,
+    # switched to and from with setStatModel when the system is drained
+    stat_dram = Param.StatDRAMInterface(
+        NULL, "Statistical model standing in for dram when switched to"
+    )
+
     # read and write buffer depths are set in the interface
     # the controller will read these values when instantiated
 
@@ -90,6 +99,12 @@ class MemCtrl(QoSMemCtrl):
     # scheduler, address map and page policy
     mem_sched_policy = Param.MemSched("frfcfs", "Memory scheduling policy")
 
+    # a policy object, e.g., for policy studies, overrides the built-in
+    # policy chosen by mem_sched_policy
+    sched_policy = Param.MemSchedPolicy(
+        NULL, "Scheduling policy object, overriding mem_sched_policy"
+    )
+
     # pipeline latency of the controller and PHY, split into a
     # frontend part and a backend part, with reads and writes serviced
     # by the queues only seeing the frontend contribution, and reads
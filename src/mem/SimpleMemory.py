@@ -53,6 +53,14 @@ class SimpleMemory(AbstractMemory):
     bandwidth = Param.MemoryBandwidth(
         "12.8GiB/s", "Combined read and write bandwidth"
     )
+    # Accept timing packets that carry no data, e.g. from traffic
+    # generators that only study the latency and bandwidth. Writes then
+    # leave the memory unchanged, and reads respond with a pointer to the
+    # backing store rather than a copy, so they see the data as it is
+    # when the response is sent.
+    backdoor_timing = Param.Bool(
+        False, "Accept timing packets without data"
+    )
 
     def controller(self):
         # Simple memory doesn't use a MemCtrl
@@ -0,0 +1,89 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.objects.MemInterface import MemInterface
+
+# A statistical stand-in for a detailed DRAM interface, e.g., to warm
+# up caches over long phases without simulating the per-bank state
+# machines. Rather than queueing bursts and tracking the banks, every
+# read is served with a latency drawn from the row hit, miss (closed
+# bank) and conflict probabilities observed on the detailed interface,
+# plus a queueing term that grows with the bandwidth the model sees.
+# The controller switches between the two at drain points, see
+# MemCtrl.setStatModel, and the model is recalibrated from the detailed
+# interval preceding every switch. The data stays with the detailed
+# interface, and the organisation and timing are taken from it.
+class StatDRAMInterface(MemInterface):
+    type = "StatDRAMInterface"
+    cxx_header = "mem/stat_dram_interface.hh"
+    cxx_class = "gem5::memory::StatDRAMInterface"
+
+    detailed = Param.DRAMInterface(
+        "Detailed interface the model is calibrated from and stands in for"
+    )
+
+    # the data lives in the detailed interface
+    null = True
+    in_addr_map = False
+    kvm_map = False
+    conf_table_reported = False
+    range = Self.detailed.range
+
+    write_buffer_size = Self.detailed.write_buffer_size
+    read_buffer_size = Self.detailed.read_buffer_size
+    addr_mapping = Self.detailed.addr_mapping
+    device_size = Self.detailed.device_size
+    device_bus_width = Self.detailed.device_bus_width
+    burst_length = Self.detailed.burst_length
+    device_rowbuffer_size = Self.detailed.device_rowbuffer_size
+    devices_per_rank = Self.detailed.devices_per_rank
+    ranks_per_channel = Self.detailed.ranks_per_channel
+    banks_per_rank = Self.detailed.banks_per_rank
+    tCK = Self.detailed.tCK
+    tBURST = Self.detailed.tBURST
+    tWTR = Self.detailed.tWTR
+    tRTW = Self.detailed.tRTW
+    tCS = Self.detailed.tCS
+
+    tRCD = Param.Latency(Self.detailed.tRCD, "RAS to Read CAS delay")
+    tCL = Param.Latency(Self.detailed.tCL, "Read CAS latency")
+    tRP = Param.Latency(Self.detailed.tRP, "Row precharge time")
+
+    # used until the model has seen a long enough detailed interval
+    row_hit_prob = Param.Float(0.5, "Row hit probability, uncalibrated")
+    row_conflict_prob = Param.Float(
+        0.25, "Row conflict probability, uncalibrated"
+    )
+
+    # shorter detailed intervals keep the previous calibration
+    calibration_min_bursts = Param.Unsigned(
+        1000, "Minimum bursts in a detailed interval to calibrate from"
+    )
+
+    # the bandwidth for the queueing term is measured over windows of
+    # this length, and the utilisation it implies is capped to keep
+    # the queueing term finite
+    bandwidth_window = Param.Latency("1us", "Bandwidth measurement window")
+    max_utilization = Param.Float(0.95, "Utilisation cap of the model")
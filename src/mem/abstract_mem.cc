@@ -356,6 +356,13 @@ static inline void
 tracePacket(System *sys, const char *label, PacketPtr pkt)
 {
     int size = pkt->getSize();
+    if (!pkt->hasData()) {
+        DPRINTF(MemoryAccess, "%s from %s of size %i on address %#x "
+                "without data %c\n", label,
+                sys->getRequestorName(pkt->req->requestorId()), size,
+                pkt->getAddr(), pkt->req->isUncacheable() ? 'U' : 'C');
+        return;
+    }
     if (size == 1 || size == 2 || size == 4 || size == 8) {
         ByteOrder byte_order = sys->getGuestByteOrder();
         DPRINTF(MemoryAccess, "%s from %s of size %i on address %#x data "
@@ -443,7 +450,9 @@ AbstractMemory::access(PacketPtr pkt)
             // to do the LL/SC tracking here
             trackLoadLocked(pkt);
         }
-        if (pmemAddr) {
+        // packets without data only model the latency, see
+        // SimpleMemory::backdoorTiming
+        if (pmemAddr && pkt->hasData()) {
             pkt->setData(host_addr);
         }
         TRACE_PACKET(pkt->req->isInstFetch() ? "IFetch" : "Read");
@@ -459,7 +468,7 @@ AbstractMemory::access(PacketPtr pkt)
         // no need to do anything
     } else if (pkt->isWrite()) {
         if (writeOK(pkt)) {
-            if (pmemAddr) {
+            if (pmemAddr && pkt->hasData()) {
                 pkt->writeData(host_addr);
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
@@ -267,6 +267,17 @@ class CoherentXBar : public BaseXBar
      */
     std::unordered_set<RequestPtr> outstandingSnoop;
 
+    /**
+     * Remember where request packets came from so that we can route
+     * responses to the appropriate port. This relies on the fact that
+     * the underlying Request pointer inside the Packet stays
+     * constant. Unlike the non-coherent crossbar, the route cannot
+     * travel with the packet, as snoop responses are new packets for
+     * the same request, and a cache clean is answered with the
+     * response to another packet.
+     */
+    std::unordered_map<RequestPtr, PortID> routeTo;
+
     /**
      * Store the outstanding cache maintenance that we are expecting
      * snoop responses from so we can determine when we received all
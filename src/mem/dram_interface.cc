@@ -59,6 +59,9 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
+    if (queue.bankIndexed())
+        return chooseNextIndexed(queue, min_col_at);
+
     std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
 
     // Has minBankPrep been called to populate earliest_banks?
@@ -171,6 +174,123 @@ DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
     return std::make_pair(selected_pkt_it, selected_col_at);
 }
 
+void
+DRAMInterface::fillSchedSnapshot(const MemPacketQueue& queue,
+                                 Tick min_col_at,
+                                 sched::QueueSnapshot& snapshot) const
+{
+    assert(snapshot.size() == queue.size());
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        MemPacket *pkt = queue[i];
+        if (!pkt->isDram() || pkt->pseudoChannel != pseudoChannel ||
+                !burstReady(pkt)) {
+            continue;
+        }
+
+        const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                    bank.wrAllowedAt;
+        snapshot.ready[i] = 1;
+        snapshot.rowHit[i] = bank.openRow == pkt->row;
+        snapshot.seamless[i] = col_allowed_at <= min_col_at;
+    }
+}
+
+std::pair<MemPacketQueue::iterator, Tick>
+DRAMInterface::chooseNextIndexed(MemPacketQueue& queue, Tick min_col_at) const
+{
+    // The scan above picks, in this order: the oldest seamless row hit;
+    // the oldest packet to another row of one of the earliest banks if
+    // its activate can be hidden; the oldest row hit; that same packet
+    // to another row. All packets to a bank share its column timing as
+    // a queue holds either reads or writes.
+    const auto &bank_queues = queue.banks(pseudoChannel);
+
+    MemPacket *seamless_pkt = nullptr;
+    MemPacket *prepped_pkt = nullptr;
+    bool found_miss = false;
+
+    for (int bank_id = 0; bank_id < bank_queues.size(); bank_id++) {
+        const auto &bank_queue = bank_queues[bank_id];
+        if (bank_queue.pkts.empty())
+            continue;
+
+        const Rank &rank = *ranks[bank_id / banksPerRank];
+        if (!rank.inRefIdleState())
+            continue;
+
+        const Bank &bank = rank.banks[bank_id % banksPerRank];
+        auto row_it = bank_queue.rows.find(bank.openRow);
+        if (row_it == bank_queue.rows.end()) {
+            found_miss = true;
+            continue;
+        }
+
+        MemPacket *hit = row_it->second.front();
+        const Tick col_allowed_at = hit->isRead() ? bank.rdAllowedAt :
+                                                    bank.wrAllowedAt;
+        MemPacket *&best = col_allowed_at <= min_col_at ?
+            seamless_pkt : prepped_pkt;
+        if (!best || hit->queueSeq < best->queueSeq)
+            best = hit;
+
+        found_miss |= row_it->second.size() != bank_queue.pkts.size();
+    }
+
+    MemPacket *selected_pkt = seamless_pkt;
+
+    if (!selected_pkt) {
+        MemPacket *earliest_pkt = nullptr;
+        bool hidden_bank_prep = false;
+
+        if (found_miss) {
+            std::vector<uint32_t> earliest_banks;
+            std::tie(earliest_banks, hidden_bank_prep) =
+                minBankPrep(queue, min_col_at);
+
+            for (int bank_id = 0; bank_id < bank_queues.size(); bank_id++) {
+                const int r = bank_id / banksPerRank;
+                const int b = bank_id % banksPerRank;
+                if (!bits(earliest_banks[r], b, b) ||
+                        !ranks[r]->inRefIdleState()) {
+                    continue;
+                }
+
+                // The oldest packet to another row than the open one
+                const uint32_t open_row = ranks[r]->banks[b].openRow;
+                for (MemPacket *pkt : bank_queues[bank_id].pkts) {
+                    if (pkt->row != open_row) {
+                        if (!earliest_pkt ||
+                                pkt->queueSeq < earliest_pkt->queueSeq) {
+                            earliest_pkt = pkt;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        selected_pkt = earliest_pkt &&
+            (hidden_bank_prep || !prepped_pkt) ? earliest_pkt : prepped_pkt;
+    }
+
+    if (!selected_pkt) {
+        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
+    }
+
+    const Bank &bank = ranks[selected_pkt->rank]->banks[selected_pkt->bank];
+    DPRINTF(DRAM, "%s selected %s packet in bank %d, row %d\n", __func__,
+            selected_pkt == seamless_pkt ? "seamless" :
+            bank.openRow == selected_pkt->row ? "prepped" : "earliest",
+            selected_pkt->bank, selected_pkt->row);
+
+    return std::make_pair(queue.find(selected_pkt),
+                          selected_pkt->isRead() ? bank.rdAllowedAt :
+                                                   bank.wrAllowedAt);
+}
+
 void
 DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
                        Tick act_tick, uint32_t row)
@@ -371,12 +491,16 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
 
     // Determine the access latency and update the bank state
     if (bank_ref.openRow == mem_pkt->row) {
-        // nothing to do
+        profile.rowHits++;
     } else {
         row_hit = false;
 
-        // If there is a page open, precharge it.
-        if (bank_ref.openRow != Bank::NO_ROW) {
+        // If there is a page open, precharge it, and keep track of
+        // which of the two it was for a statistical model
+        if (bank_ref.openRow == Bank::NO_ROW) {
+            profile.rowMisses++;
+        } else {
+            profile.rowConflicts++;
             prechargeBank(rank_ref, bank_ref, std::max(bank_ref.preAllowedAt,
                                                    curTick()));
         }
@@ -586,6 +710,9 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         stats.totMemAccLat += mem_pkt->readyTime - mem_pkt->entryTime;
         stats.totQLat += cmd_at - mem_pkt->entryTime;
         stats.totBusLat += tBURST;
+
+        profile.readBursts++;
+        profile.readQueueLat += cmd_at - mem_pkt->entryTime;
     } else {
         // Schedule write done event to decrement event count
         // after the readyTime has been reached
@@ -612,10 +739,21 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         stats.perBankWrBursts[mem_pkt->bankId]++;
 
     }
+    profile.bytes += burstSize;
+
     // Update bus state to reflect when previous command was issued
     return std::make_pair(cmd_at, cmd_at + burst_gap);
 }
 
+DRAMInterface::AccessProfile
+DRAMInterface::takeProfile()
+{
+    AccessProfile taken = profile;
+    profile = AccessProfile();
+    profile.since = curTick();
+    return taken;
+}
+
 void
 DRAMInterface::addRankToRankDelay(Tick cmd_at)
 {
@@ -657,6 +795,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      deferIdleRefresh(_p.defer_idle_refresh),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -1001,6 +1140,19 @@ DRAMInterface::drainRanks()
     }
 }
 
+void
+DRAMInterface::catchUpRefresh()
+{
+    // ranks refreshing in lockstep restart the scheduler only once
+    std::set<Tick> restarts;
+    for (auto r : ranks) {
+        r->catchUpRefresh(restarts);
+    }
+    for (size_t i = 0; i < restarts.size(); ++i) {
+        ctrl->recordIdleRestart();
+    }
+}
+
 bool
 DRAMInterface::allRanksDrained() const
 {
@@ -1019,6 +1171,7 @@ DRAMInterface::allRanksDrained() const
 void
 DRAMInterface::suspend()
 {
+    catchUpRefresh();
     for (auto r : ranks) {
         r->suspend();
     }
@@ -1041,11 +1194,21 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+    if (queue.bankIndexed()) {
+        const auto &bank_queues = queue.banks(pseudoChannel);
+        for (int bank_id = 0; bank_id < bank_queues.size(); bank_id++) {
+            if (!bank_queues[bank_id].pkts.empty() &&
+                    ranks[bank_id / banksPerRank]->inRefIdleState()) {
+                got_waiting[bank_id] = true;
+            }
+        }
+    } else {
+        for (const auto& p : queue) {
+            if (p->pseudoChannel != pseudoChannel)
+                continue;
+            if (p->isDram() && ranks[p->rank]->inRefIdleState())
+                got_waiting[p->bankId] = true;
+        }
     }
 
     // Find command with optimal bank timing
@@ -1204,7 +1367,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick tick)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1214,19 +1377,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= tick) {
+             // Move all commands at or before tick to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before tick
+             // next_iter references the 1st command after tick
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after tick
+    // if there are no commands after tick, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1404,34 +1567,9 @@ DRAMInterface::Rank::processRefreshEvent()
         assert(numBanksActive == 0);
         assert(pwrState == PWR_REF);
 
-        Tick ref_done_at = curTick() + dram.tRFC;
-
-        for (auto &b : banks) {
-            b.actAllowedAt = ref_done_at;
-        }
-
-        // at the moment this affects all ranks
-        cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
-
-        // Update the stats
-        updatePowerStats();
-
-        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
-                dram.timeStampOffset, rank);
-
-        // Update for next refresh
-        refreshDueAt += dram.tREFI;
-
-        // make sure we did not wait so long that we cannot make up
-        // for it
-        if (refreshDueAt < ref_done_at) {
-            fatal("Refresh was delayed so long we cannot catch up\n");
-        }
-
         // Run the refresh and schedule event to transition power states
         // when refresh completes
-        refreshState = REF_RUN;
-        schedule(refreshEvent, ref_done_at);
+        schedule(refreshEvent, issueRefresh(curTick()));
         return;
     }
 
@@ -1481,11 +1619,116 @@ DRAMInterface::Rank::processRefreshEvent()
         // refresh STM and therefore can always schedule next event.
         // Compensate for the delay in actually performing the refresh
         // when scheduling the next one
-        schedule(refreshEvent, refreshDueAt - dram.tRP);
+        if (canDeferRefresh()) {
+            // only refreshes happen until the next request arrives,
+            // so account for them then instead of running them
+            refreshDeferred = true;
+
+            DPRINTF(DRAMState, "Refresh done at %llu and deferring the "
+                    "refreshes from %llu\n", curTick(), refreshDueAt);
+        } else {
+            schedule(refreshEvent, refreshDueAt - dram.tRP);
+
+            DPRINTF(DRAMState, "Refresh done at %llu and next refresh"
+                    " at %llu\n", curTick(), refreshDueAt);
+        }
+    }
+}
+
+Tick
+DRAMInterface::Rank::issueRefresh(Tick ref_at)
+{
+    Tick ref_done_at = ref_at + dram.tRFC;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    // at the moment this affects all ranks
+    cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+
+    // Update the stats
+    updatePowerStats(ref_at);
+
+    DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_at, dram.tCK) -
+            dram.timeStampOffset, rank);
 
-        DPRINTF(DRAMState, "Refresh done at %llu and next refresh"
-                " at %llu\n", curTick(), refreshDueAt);
+    // Update for next refresh
+    refreshDueAt += dram.tREFI;
+
+    // make sure we did not wait so long that we cannot make up
+    // for it
+    if (refreshDueAt < ref_done_at) {
+        fatal("Refresh was delayed so long we cannot catch up\n");
+    }
+
+    refreshState = REF_RUN;
+    return ref_done_at;
+}
+
+bool
+DRAMInterface::Rank::canDeferRefresh() const
+{
+    // Without power-down, an idle rank goes through the same refresh
+    // sequence every tREFI, and the only other effect of it is the
+    // scheduler restart once the rank is back in PWR_IDLE. The bus
+    // must stay in the read state for the restarts to do nothing but
+    // count as such.
+    return dram.deferIdleRefresh && !dram.enableDRAMPowerdown &&
+        pwrStateTrans == PWR_IDLE && outstandingEvents == 1 &&
+        !activateEvent.scheduled() && !prechargeEvent.scheduled() &&
+        !writeDoneEvent.scheduled() && !wakeUpEvent.scheduled() &&
+        dram.readQueueSize == 0 && dram.writeQueueSize == 0 &&
+        dram.busState == MemCtrl::READ &&
+        dram.busStateNext == MemCtrl::READ &&
+        dram.ctrl->isIdle(dram.pseudoChannel);
+}
+
+void
+DRAMInterface::Rank::catchUpRefresh(std::set<Tick> &restarts)
+{
+    if (!refreshDeferred)
+        return;
+
+    refreshDeferred = false;
+
+    // Replay the refreshes that started before now. Each moves the
+    // rank from PWR_IDLE to PWR_REF, issues the refresh and returns
+    // to PWR_IDLE tRFC later, as processRefreshEvent and
+    // processPowerEvent do for an idle rank.
+    Tick ref_at = refreshDueAt - dram.tRP;
+    while (ref_at < curTick()) {
+        DPRINTF(DRAMState, "Catching up with refresh at %llu\n", ref_at);
+
+        refreshDueAt = ref_at;
+        ++outstandingEvents;
+
+        stats.pwrStateTime[pwrState] += ref_at - pwrStateTick;
+        pwrState = PWR_REF;
+        pwrStateTrans = PWR_REF;
+        pwrStateTick = ref_at;
+
+        Tick ref_done_at = issueRefresh(ref_at);
+        if (ref_done_at >= curTick()) {
+            // still refreshing, let the events complete it
+            schedule(refreshEvent, ref_done_at);
+            return;
+        }
+
+        stats.pwrStateTime[PWR_REF] += ref_done_at - pwrStateTick;
+        pwrState = PWR_IDLE;
+        pwrStateTrans = PWR_IDLE;
+        pwrStateTick = ref_done_at;
+
+        --outstandingEvents;
+        refreshState = REF_IDLE;
+
+        restarts.insert(ref_done_at);
+
+        ref_at = refreshDueAt - dram.tRP;
     }
+
+    schedule(refreshEvent, ref_at);
 }
 
 void
@@ -1764,17 +2007,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick tick)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(tick);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
-    // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    // and is upto the given tick.
+    power.powerlib.calcWindowEnergy(divCeil(tick, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1802,7 +2045,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (tick - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -46,6 +46,8 @@
 #ifndef __DRAM_INTERFACE_HH__
 #define __DRAM_INTERFACE_HH__
 
+#include <set>
+
 #include "mem/drampower.hh"
 #include "mem/mem_interface.hh"
 #include "params/DRAMInterface.hh"
@@ -64,6 +66,27 @@ namespace memory
  */
 class DRAMInterface : public MemInterface
 {
+  public:
+    /**
+     * What the bursts of an interval saw, for calibrating a
+     * statistical model of the interface, see StatDRAMInterface.
+     */
+    struct AccessProfile
+    {
+        /** Bursts to an open row, a closed bank, and another row */
+        uint64_t rowHits = 0;
+        uint64_t rowMisses = 0;
+        uint64_t rowConflicts = 0;
+
+        uint64_t readBursts = 0;
+        /** Time the reads were queued in the controller */
+        Tick readQueueLat = 0;
+        uint64_t bytes = 0;
+
+        /** Start of the interval */
+        Tick since = 0;
+    };
+
   private:
     /**
      * Simple structure to hold the values needed to keep track of
@@ -256,10 +279,35 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * The refreshes from refreshDueAt onwards are not scheduled as
+         * the controller is idle, see catchUpRefresh()
+         */
+        bool refreshDeferred = false;
+
         /**
          * Function to update Power Stats
+         *
+         * @param tick Tick up to which to account the energy
+         */
+        void updatePowerStats(Tick tick = curTick());
+
+        /**
+         * Issue the refresh command of a refresh starting at a given
+         * tick, moving the refresh state machine to REF_RUN
+         *
+         * @param ref_at Tick at which the refresh starts
+         * @return Tick at which the refresh completes
+         */
+        Tick issueRefresh(Tick ref_at);
+
+        /**
+         * Can the refreshes following the one completing now be
+         * deferred? This is the case when the controller is idle and
+         * the rank does not power down, as then the refreshes are all
+         * that happens until the next request arrives.
          */
-        void updatePowerStats();
+        bool canDeferRefresh() const;
 
         /**
          * Schedule a power state transition in the future, and
@@ -419,13 +467,26 @@ class DRAMInterface : public MemInterface
          */
         void checkDrainDone();
 
+        /**
+         * Account for the refreshes deferred while the controller was
+         * idle, exactly as the refresh and power events would have
+         * done, and schedule the refresh events again. A refresh still
+         * in progress continues with its events.
+         *
+         * @param restarts ticks at which a completed refresh would
+         *                 have restarted the scheduler
+         */
+        void catchUpRefresh(std::set<Tick> &restarts);
+
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
+         * or before a tick to DRAMPower library
          * All commands before curTick are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param tick Tick up to which to push commands
          */
-        void flushCmdList();
+        void flushCmdList(Tick tick = curTick());
 
         /**
          * Computes stats just prior to dump event
@@ -544,6 +605,9 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Defer the refreshes of the ranks while the controller is idle */
+    const bool deferIdleRefresh;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -626,6 +690,9 @@ class DRAMInterface : public MemInterface
 
     DRAMStats stats;
 
+    /** Profile of the bursts since takeProfile() */
+    AccessProfile profile;
+
     /**
       * Vector of dram ranks
       */
@@ -649,6 +716,13 @@ class DRAMInterface : public MemInterface
     std::pair<std::vector<uint32_t>, bool>
     minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
 
+    /**
+     * chooseNextFRFCFS for queues with a bank index. Makes the same
+     * choice while looking at every bank rather than every packet.
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextIndexed(MemPacketQueue& queue, Tick min_col_at) const;
+
     /*
      * @return time to send a burst of data without gaps
      */
@@ -702,6 +776,11 @@ class DRAMInterface : public MemInterface
      */
     void suspend() override;
 
+    /**
+     * Account for the refreshes the ranks deferred while idle
+     */
+    void catchUpRefresh() override;
+
     /*
      * @return time to offset next command
      */
@@ -726,6 +805,9 @@ class DRAMInterface : public MemInterface
     std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
 
+    void fillSchedSnapshot(const MemPacketQueue& queue, Tick min_col_at,
+                           sched::QueueSnapshot& snapshot) const override;
+
     /**
      * Actually do the burst - figure out the latency it
      * will take to service the req based on bank state, channel state etc
@@ -800,6 +882,12 @@ class DRAMInterface : public MemInterface
     void chooseRead(MemPacketQueue& queue) override { }
     bool writeRespQueueFull() const override { return false;}
 
+    /**
+     * Get the profile of the bursts since the last call, and start
+     * profiling a new interval.
+     */
+    AccessProfile takeProfile();
+
     DRAMInterface(const DRAMInterfaceParams &_p);
 };
 
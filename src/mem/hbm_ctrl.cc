@@ -64,6 +64,7 @@ HBMCtrl::HBMCtrl(const HBMCtrlParams &p) :
 
     fatal_if(!pc0Int, "Memory controller must have pc0 interface");
     fatal_if(!pc1Int, "Memory controller must have pc1 interface");
+    fatal_if(statDram, "HBMCtrl does not support statistical DRAM models");
 
     pc0Int->setCtrl(this, commandWindow, 0);
     pc1Int->setCtrl(this, commandWindow, 1);
@@ -460,6 +461,13 @@ HBMCtrl::verifyMultiCmd(Tick cmd_tick, Tick max_cmds_per_burst,
     return cmd_at;
 }
 
+void
+HBMCtrl::catchUpRefresh()
+{
+    MemCtrl::catchUpRefresh();
+    pc1Int->catchUpRefresh();
+}
+
 void
 HBMCtrl::drainResume()
 {
@@ -248,6 +248,8 @@ class HBMCtrl : public MemCtrl
         }
     }
 
+    void catchUpRefresh() override;
+
 
     virtual void init() override;
     virtual void startup() override;
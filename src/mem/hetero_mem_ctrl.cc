@@ -69,6 +69,10 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
             "HeteroMemCtrl's dram interface must be of type DRAMInterface.\n");
     fatal_if(dynamic_cast<NVMInterface*>(nvm) == nullptr,
             "HeteroMemCtrl's nvm interface must be of type NVMInterface.\n");
+    fatal_if(schedPolicy,
+            "HeteroMemCtrl does not support scheduling policy objects.\n");
+    fatal_if(statDram,
+            "HeteroMemCtrl does not support statistical DRAM models.\n");
 
     // hook up interfaces to the controller
     dram->setCtrl(this, commandWindow);
@@ -194,7 +198,7 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 HeteroMemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -415,6 +419,9 @@ HeteroMemCtrl::allIntfDrained() const
 DrainState
 HeteroMemCtrl::drain()
 {
+    // bring the refreshes deferred while idle up to date
+    catchUpRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -49,6 +51,7 @@
 #include "mem/dram_interface.hh"
 #include "mem/mem_interface.hh"
 #include "mem/nvm_interface.hh"
+#include "mem/stat_dram_interface.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -57,6 +60,66 @@ namespace gem5
 namespace memory
 {
 
+void
+MemPacketQueue::enableBankIndex()
+{
+    assert(empty());
+    indexed = true;
+}
+
+const std::vector<MemPacketQueue::BankQueue> &
+MemPacketQueue::banks(uint8_t pseudo_channel) const
+{
+    static const std::vector<BankQueue> no_banks;
+    return pseudo_channel < bankQueues.size() ?
+        bankQueues[pseudo_channel] : no_banks;
+}
+
+void
+MemPacketQueue::addToIndex(MemPacket *pkt)
+{
+    if (!pkt->isDram())
+        return;
+
+    if (pkt->pseudoChannel >= bankQueues.size())
+        bankQueues.resize(pkt->pseudoChannel + 1);
+    auto &banks = bankQueues[pkt->pseudoChannel];
+    if (pkt->bankId >= banks.size())
+        banks.resize(pkt->bankId + 1);
+
+    BankQueue &bank = banks[pkt->bankId];
+    bank.pkts.push_back(pkt);
+    bank.rows[pkt->row].push_back(pkt);
+}
+
+void
+MemPacketQueue::removeFromIndex(MemPacket *pkt)
+{
+    if (!pkt->isDram())
+        return;
+
+    BankQueue &bank = bankQueues[pkt->pseudoChannel][pkt->bankId];
+    auto pkt_it = std::find(bank.pkts.begin(), bank.pkts.end(), pkt);
+    assert(pkt_it != bank.pkts.end());
+    bank.pkts.erase(pkt_it);
+
+    auto row_it = bank.rows.find(pkt->row);
+    assert(row_it != bank.rows.end());
+    auto &row = row_it->second;
+    row.erase(std::find(row.begin(), row.end(), pkt));
+    if (row.empty())
+        bank.rows.erase(row_it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket *pkt)
+{
+    auto it = std::lower_bound(pkts.begin(), pkts.end(), pkt->queueSeq,
+        [](const MemPacket *p, uint64_t seq) { return p->queueSeq < seq; });
+    assert(it != pkts.end() && *it == pkt);
+    return it;
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -65,7 +128,9 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
                          respondEvent, nextReqEvent, retryWrReq);}, name()),
     respondEvent([this] {processRespondEvent(dram, respQueue,
                          respondEvent, retryRdReq); }, name()),
-    dram(p.dram),
+    statRetryEvent([this] { processStatRetryEvent(); }, name()),
+    dram(p.dram), statDram(p.stat_dram),
+    statModel(false), statModelNext(false),
     readBufferSize(dram->readBufferSize),
     writeBufferSize(dram->writeBufferSize),
     writeHighThreshold(writeBufferSize * p.write_high_thresh_perc / 100.0),
@@ -73,6 +138,7 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     minWritesPerSwitch(p.min_writes_per_switch),
     minReadsPerSwitch(p.min_reads_per_switch),
     memSchedPolicy(p.mem_sched_policy),
+    schedPolicy(p.sched_policy),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
     commandWindow(p.command_window),
@@ -83,6 +149,10 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
 
     readQueue.resize(p.qos_priorities);
     writeQueue.resize(p.qos_priorities);
+    for (auto &queue : readQueue)
+        queue.enableBankIndex();
+    for (auto &queue : writeQueue)
+        queue.enableBankIndex();
 
     dram->setCtrl(this, commandWindow);
 
@@ -94,6 +164,9 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     if (p.disable_sanity_check) {
         port.disableSanityCheck();
     }
+
+    fatal_if(statDram && statDram->getAddrRange() != dram->getAddrRange(),
+             "%s: stat_dram must be a model of dram\n", name());
 }
 
 void
@@ -425,6 +498,9 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(dram->getAddrRange().contains(pkt->getAddr())),
              "Can't handle address range for packet %s\n", pkt->print());
 
+    if (statModel)
+        return recvTimingReqStat(pkt);
+
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
     // translates to only one memory packet. Otherwise, a pkt translates to
@@ -484,9 +560,56 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     return true;
 }
 
+bool
+MemCtrl::recvTimingReqStat(PacketPtr pkt)
+{
+    // forget the reads that got their response
+    while (!statReadsDue.empty() && statReadsDue.top() <= curTick())
+        statReadsDue.pop();
+
+    const unsigned size = pkt->getSize();
+    if (pkt->isWrite()) {
+        // writes complete in the write buffer, as in the detailed case
+        statDram->serve(pkt);
+        accessAndRespond(pkt, frontendLatency, dram);
+        stats.writeReqs++;
+        stats.bytesWrittenSys += size;
+    } else {
+        // bound the reads in flight by what the read queue would hold,
+        // which also keeps the response queue of the port in check
+        if (statReadsDue.size() >= readBufferSize) {
+            DPRINTF(MemCtrl, "Statistical model reads full, not accepting\n");
+            retryRdReq = true;
+            stats.numRdRetry++;
+            if (!statRetryEvent.scheduled())
+                schedule(statRetryEvent, statReadsDue.top());
+            return false;
+        }
+
+        const Tick latency = frontendLatency + statDram->serve(pkt) +
+            backendLatency;
+        statReadsDue.push(curTick() + latency + pkt->headerDelay +
+                          pkt->payloadDelay);
+        accessAndRespond(pkt, latency, dram);
+        stats.readReqs++;
+        stats.bytesReadSys += size;
+    }
+
+    return true;
+}
+
+void
+MemCtrl::processStatRetryEvent()
+{
+    if (retryRdReq) {
+        retryRdReq = false;
+        port.sendRetryReq();
+    }
+}
+
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -562,7 +685,9 @@ MemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
     MemPacketQueue::iterator ret = queue.end();
 
     if (!queue.empty()) {
-        if (queue.size() == 1) {
+        if (schedPolicy) {
+            ret = chooseNextPolicy(queue, extra_col_delay, mem_intr);
+        } else if (queue.size() == 1) {
             // available rank corresponds to state refresh idle
             MemPacket* mem_pkt = *(queue.begin());
             if (mem_pkt->pseudoChannel != mem_intr->pseudoChannel) {
@@ -618,6 +743,30 @@ MemCtrl::chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
     return std::make_pair(selected_pkt_it, col_allowed_at);
 }
 
+MemPacketQueue::iterator
+MemCtrl::chooseNextPolicy(MemPacketQueue& queue, Tick extra_col_delay,
+                          MemInterface* mem_intr)
+{
+    schedSnapshot.clear();
+    for (const MemPacket *mem_pkt : queue) {
+        schedSnapshot.add(mem_pkt->bankId, mem_pkt->row, mem_pkt->entryTime,
+                          mem_pkt->requestorId(), mem_pkt->qosValue());
+    }
+
+    // time we need to issue a column command to be seamless
+    const Tick min_col_at = std::max(mem_intr->nextBurstAt + extra_col_delay,
+                                     curTick());
+    mem_intr->fillSchedSnapshot(queue, min_col_at, schedSnapshot);
+
+    const size_t chosen = schedPolicy->choose(schedSnapshot);
+    if (chosen == schedSnapshot.size()) {
+        DPRINTF(MemCtrl, "%s no available packets found\n", __func__);
+        return queue.end();
+    }
+
+    return queue.begin() + chosen;
+}
+
 void
 MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr)
@@ -879,7 +1028,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -1422,9 +1571,29 @@ MemCtrl::allIntfDrained() const
    return dram->allRanksDrained();
 }
 
+bool
+MemCtrl::isIdle(uint8_t pseudo_channel)
+{
+    // with a turnaround policy the bus direction may change even when
+    // there is nothing to do
+    return !turnPolicy && drainState() == DrainState::Running &&
+        !totalReadQueueSize && !totalWriteQueueSize && respQEmpty() &&
+        !requestEventScheduled(pseudo_channel) &&
+        !respondEventScheduled(pseudo_channel);
+}
+
+void
+MemCtrl::catchUpRefresh()
+{
+    dram->catchUpRefresh();
+}
+
 DrainState
 MemCtrl::drain()
 {
+    // bring the refreshes deferred while idle up to date
+    catchUpRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (totalWriteQueueSize || totalReadQueueSize || !respQEmpty() ||
@@ -1448,22 +1617,73 @@ MemCtrl::drain()
     }
 }
 
+void
+MemCtrl::setStatModel(bool enable)
+{
+    fatal_if(enable && !statDram, "%s: No statistical model to switch to\n",
+             name());
+    panic_if(drainState() != DrainState::Drained,
+             "%s: Memory models can only be switched when drained\n",
+             name());
+    statModelNext = enable;
+}
+
 void
 MemCtrl::drainResume()
 {
-    if (!isTimingMode && system()->isTimingMode()) {
+    const bool timing_mode = system()->isTimingMode();
+
+    // the ranks only run while the detailed interface serves requests
+    // in timing mode
+    const bool ranks_active = isTimingMode && !statModel;
+    const bool ranks_next = timing_mode && !statModelNext;
+
+    // atomic and functional accesses always go to the detailed
+    // interface, so the model only stands in for it in timing mode
+    warn_if_once(statModelNext && !timing_mode,
+                 "%s: The statistical model only serves timing requests, "
+                 "atomic warming bypasses it\n", name());
+
+    if (statModelNext && !statModel) {
+        statDram->calibrate();
+    } else if (!statModelNext && statModel) {
+        statDram->startInterval();
+    }
+
+    if (!isTimingMode && timing_mode) {
         // if we switched to timing mode, kick things into action,
         // and behave as if we restored from a checkpoint
         startup();
+    }
+
+    if (!ranks_active && ranks_next) {
         dram->startup();
-    } else if (isTimingMode && !system()->isTimingMode()) {
+    } else if (ranks_active && !ranks_next) {
         // if we switch from timing mode, stop the refresh events to
-        // not cause issues with KVM
+        // not cause issues with KVM, and do the same when the model
+        // stands in for the ranks
         dram->suspend();
     }
 
     // update the mode
-    isTimingMode = system()->isTimingMode();
+    isTimingMode = timing_mode;
+    statModel = statModelNext;
+}
+
+void
+MemCtrl::resetStats()
+{
+    // account for the refreshes deferred while idle in the stats
+    // being reset, the interfaces are reset after the controller
+    catchUpRefresh();
+    qos::MemCtrl::resetStats();
+}
+
+void
+MemCtrl::preDumpStats()
+{
+    catchUpRefresh();
+    qos::MemCtrl::preDumpStats();
 }
 
 AddrRangeList
@@ -1524,6 +1744,9 @@ MemCtrl::MemoryPort::recvAtomicBackdoor(
 bool
 MemCtrl::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
+    // the refreshes deferred while idle happened before this request
+    ctrl.catchUpRefresh();
+
     // pass it to the memory controller
     return ctrl.recvTimingReq(pkt);
 }
@@ -47,7 +47,10 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <functional>
+#include <queue>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -57,6 +60,7 @@
 #include "enums/MemSched.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
+#include "mem/sched/policy.hh"
 #include "params/MemCtrl.hh"
 #include "sim/eventq.hh"
 
@@ -69,6 +73,7 @@ namespace memory
 class MemInterface;
 class DRAMInterface;
 class NVMInterface;
+class StatDRAMInterface;
 
 /**
  * A burst helper helps organize and manage a packet that is larger than
@@ -156,6 +161,12 @@ class MemPacket
      */
     uint8_t _qosValue;
 
+    /**
+     * Position in the queue holding the packet, increasing from the
+     * front to the back of the queue
+     */
+    uint64_t queueSeq;
+
     /**
      * Set the packet QoS value
      * (interface compatibility with Packet)
@@ -210,14 +221,102 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
+          burstHelper(NULL), _qosValue(_pkt->qosValue()), queueSeq(0)
     { }
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * The memory packets are store in a multiple dequeue structure, based
+ * on their QoS priority.
+ *
+ * The request queues also keep an index of their DRAM packets by bank
+ * and row, so that the DRAM scheduler can find row hits and the packets
+ * of the earliest banks by looking at the banks rather than at every
+ * packet. The queue only offers the modifiers that keep the index up
+ * to date, push_back, erase and pop_front.
+ */
+class MemPacketQueue
+{
+  private:
+    std::deque<MemPacket*> pkts;
+
+  public:
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    /** The DRAM packets to one bank, in queue order */
+    struct BankQueue
+    {
+        std::deque<MemPacket*> pkts;
+
+        /** The same packets by row */
+        std::unordered_map<uint32_t, std::deque<MemPacket*>> rows;
+    };
+
+  private:
+    bool indexed = false;
+
+    uint64_t nextSeq = 0;
+
+    /** Bank queues by pseudo channel and bank id */
+    std::vector<std::vector<BankQueue>> bankQueues;
+
+    void addToIndex(MemPacket *pkt);
+    void removeFromIndex(MemPacket *pkt);
+
+  public:
+    /** Start indexing the packets, only allowed while empty */
+    void enableBankIndex();
+
+    bool bankIndexed() const { return indexed; }
+
+    /**
+     * The bank queues of a pseudo channel by bank id. Banks past the
+     * end of the vector have no packets.
+     */
+    const std::vector<BankQueue> &banks(uint8_t pseudo_channel) const;
+
+    iterator begin() { return pkts.begin(); }
+    iterator end() { return pkts.end(); }
+    const_iterator begin() const { return pkts.begin(); }
+    const_iterator end() const { return pkts.end(); }
+
+    size_t size() const { return pkts.size(); }
+    bool empty() const { return pkts.empty(); }
+
+    MemPacket *front() const { return pkts.front(); }
+    MemPacket *back() const { return pkts.back(); }
+    MemPacket *operator[](size_t i) const { return pkts[i]; }
+
+    void
+    push_back(MemPacket *pkt)
+    {
+        pkt->queueSeq = nextSeq++;
+        if (indexed)
+            addToIndex(pkt);
+        pkts.push_back(pkt);
+    }
+
+    iterator
+    erase(iterator it)
+    {
+        if (indexed)
+            removeFromIndex(*it);
+        return pkts.erase(it);
+    }
+
+    void
+    pop_front()
+    {
+        if (indexed)
+            removeFromIndex(pkts.front());
+        pkts.pop_front();
+    }
+
+    /** Find a packet of the queue from its position */
+    iterator find(const MemPacket *pkt);
+};
 
 
 /**
@@ -300,18 +399,25 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
 
+    /**
+     * Retry a read turned away while the statistical model had as
+     * many reads outstanding as the read queue holds
+     */
+    void processStatRetryEvent();
+    EventFunctionWrapper statRetryEvent;
+
     /**
      * Check if the read queue has room for more entries
      *
@@ -432,6 +538,17 @@ class MemCtrl : public qos::MemCtrl
     chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
                     MemInterface* mem_intr);
 
+    /**
+     * Let the scheduling policy choose from a snapshot of the queue.
+     *
+     * @param queue Queued requests to consider
+     * @param extra_col_delay Any extra delay due to a read/write switch
+     * @param mem_intr the memory interface to choose from
+     * @return an iterator to the selected packet, else queue.end()
+     */
+    MemPacketQueue::iterator chooseNextPolicy(MemPacketQueue& queue,
+        Tick extra_col_delay, MemInterface* mem_intr);
+
     /**
      * Calculate burst window aligned tick
      *
@@ -503,6 +620,28 @@ class MemCtrl : public qos::MemCtrl
 +    */
     MemInterface* dram;
 
+    /**
+     * Statistical model of dram, serving the requests instead of it
+     * when switched to, and whether it is used now and after the next
+     * drainResume().
+     */
+    StatDRAMInterface* statDram;
+    bool statModel;
+    bool statModelNext;
+
+    /** Response ticks of the reads served by the model */
+    std::priority_queue<Tick, std::vector<Tick>, std::greater<Tick>>
+        statReadsDue;
+
+    /**
+     * Serve a request with the statistical model, bypassing the
+     * queues and the interface state
+     *
+     * @param pkt The request
+     * @return Whether the request was accepted
+     */
+    bool recvTimingReqStat(PacketPtr pkt);
+
     virtual AddrRangeList getAddrRanges();
 
     /**
@@ -524,6 +663,13 @@ class MemCtrl : public qos::MemCtrl
      */
     enums::MemSched memSchedPolicy;
 
+    /**
+     * Scheduling policy overriding memSchedPolicy if set, and the
+     * snapshot of the queue handed to it.
+     */
+    sched::Policy *schedPolicy;
+    sched::QueueSnapshot schedSnapshot;
+
     /**
      * Pipeline latency of the controller frontend. The frontend
      * contribution is added to writes (that complete when they are in
@@ -686,6 +832,16 @@ class MemCtrl : public qos::MemCtrl
 
     DrainState drain() override;
 
+    /**
+     * Switch to the statistical model of the memory, or back to the
+     * detailed interface, once the system resumes from being drained.
+     * Switching to the model calibrates it from the detailed interval
+     * that just ended.
+     *
+     * @param enable Whether to switch to the statistical model
+     */
+    void setStatModel(bool enable);
+
     /**
      * Check for command bus contention for single cycle command.
      * If there is contention, shift command to next burst.
@@ -756,6 +912,31 @@ class MemCtrl : public qos::MemCtrl
         schedule(nextReqEvent, tick);
     }
 
+    /**
+     * Is the controller idle, with no requests queued or in flight,
+     * and a scheduler that would find nothing to do if restarted?
+     * Interfaces may then defer their maintenance until the next
+     * request arrives, see MemInterface::catchUpRefresh().
+     *
+     * @param pseudo_channel pseudo channel number to check
+     * @return true if the controller is idle
+     */
+    bool isIdle(uint8_t pseudo_channel = 0);
+
+    /**
+     * Account for a scheduler restart by a deferred refresh, which
+     * finds the controller idle and only records the bus staying in
+     * the read state. The interface calls this once per restart of
+     * the channel, not once per rank.
+     */
+    void recordIdleRestart() { recordTurnaroundStats(READ, READ); }
+
+    /**
+     * Let the interfaces account for the maintenance they deferred
+     * while the controller was idle.
+     */
+    virtual void catchUpRefresh();
+
     /**
      * Check the current direction of the memory channel
      *
@@ -779,6 +960,9 @@ class MemCtrl : public qos::MemCtrl
     virtual void startup() override;
     virtual void drainResume() override;
 
+    void resetStats() override;
+    void preDumpStats() override;
+
   protected:
 
     virtual Tick recvAtomic(PacketPtr pkt);
@@ -267,6 +267,19 @@ class MemInterface : public AbstractMemory
     virtual std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const = 0;
 
+    /**
+     * Fill in the fields of a scheduling snapshot that depend on the
+     * media: whether each packet can issue, hits an open row, and can
+     * issue its column command seamlessly.
+     *
+     * @param queue Queued requests the snapshot was taken of
+     * @param min_col_at Minimum tick for 'seamless' issue
+     * @param snapshot The snapshot, with an entry per queued request
+     */
+    virtual void fillSchedSnapshot(const MemPacketQueue& queue,
+                                   Tick min_col_at,
+                                   sched::QueueSnapshot& snapshot) const = 0;
+
     /*
      * Function to calulate unloaded latency
      */
@@ -367,6 +380,13 @@ class MemInterface : public AbstractMemory
         "not be executed from here.\n");
     };
 
+    /**
+     * Account for any maintenance deferred while the controller was
+     * idle. Called before the controller gets a new request and before
+     * its stats are dumped or reset.
+     */
+    virtual void catchUpRefresh() {}
+
     /**
      * This function is DRAM specific.
      */
@@ -260,6 +260,29 @@ NVMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
     return std::make_pair(selected_pkt_it, selected_col_at);
 }
 
+void
+NVMInterface::fillSchedSnapshot(const MemPacketQueue& queue,
+                                Tick min_col_at,
+                                sched::QueueSnapshot& snapshot) const
+{
+    assert(snapshot.size() == queue.size());
+
+    // there are no rows to keep open, so all packets are treated as
+    // hits, as chooseNextFRFCFS does
+    for (size_t i = 0; i < queue.size(); ++i) {
+        MemPacket *pkt = queue[i];
+        if (pkt->isDram() || !burstReady(pkt))
+            continue;
+
+        const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                    bank.wrAllowedAt;
+        snapshot.ready[i] = 1;
+        snapshot.rowHit[i] = 1;
+        snapshot.seamless[i] = col_allowed_at <= min_col_at;
+    }
+}
+
 void
 NVMInterface::chooseRead(MemPacketQueue& queue)
 {
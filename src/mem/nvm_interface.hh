@@ -251,6 +251,9 @@ class NVMInterface : public MemInterface
     std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
 
+    void fillSchedSnapshot(const MemPacketQueue& queue, Tick min_col_at,
+                           sched::QueueSnapshot& snapshot) const override;
+
     /**
      *  Add rank to rank delay to bus timing to all NVM banks in alli ranks
      *  when access to an alternate interface is issued
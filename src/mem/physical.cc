@@ -44,17 +44,27 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <thread>
 
 #include "base/intmath.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "sim/eventq.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -70,20 +80,58 @@
 #endif
 #endif
 
+/**
+ * Huge pages are only available on Linux, elsewhere the options to
+ * use them are ignored with a warning.
+ */
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0
+#endif
+
 namespace gem5
 {
 
 namespace memory
 {
 
+namespace
+{
+
+/**
+ * The default huge page size of the host, as used by MAP_HUGETLB, or
+ * zero if unknown.
+ */
+uint64_t
+hostHugePageSize()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    while (meminfo >> key) {
+        if (key == "Hugepagesize:") {
+            uint64_t size_kib;
+            if (meminfo >> size_kib)
+                return size_kib * 1024;
+            break;
+        }
+        meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               BackstoreHugePages huge_pages,
+                               unsigned prefault_threads,
+                               const std::vector<int>& numa_nodes) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), hugePages(huge_pages),
+    prefaultThreads(prefault_threads), numaNodes(numa_nodes)
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -93,6 +141,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    if (mmap_using_noreserve && prefault_threads)
+        warn("Pre-faulting the backing store reserves all of it\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -238,9 +289,36 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
-                                    PROT_READ | PROT_WRITE,
-                                    map_flags, shm_fd, map_offset);
+    uint8_t* pmem = (uint8_t*) MAP_FAILED;
+    uint64_t page_size = pageSize;
+
+    // explicit huge pages come from the pool reserved on the host, and
+    // are only used for anonymous stores made of whole huge pages
+    if (hugePages == BackstoreHugePages::hugetlb) {
+        uint64_t huge_page_size = hostHugePageSize();
+        if (!MAP_HUGETLB || !huge_page_size || shm_fd != -1 ||
+            range.size() % huge_page_size) {
+            warn("Not using explicit huge pages for range %s\n",
+                 range.to_string());
+        } else {
+            pmem = (uint8_t*) mmap(NULL, range.size(),
+                                   PROT_READ | PROT_WRITE,
+                                   map_flags | MAP_HUGETLB, shm_fd,
+                                   map_offset);
+            if (pmem == (uint8_t*) MAP_FAILED) {
+                warn("Could not mmap range %s with huge pages (%s), "
+                     "is the host pool large enough?\n", range.to_string(),
+                     std::strerror(errno));
+            } else {
+                page_size = huge_page_size;
+            }
+        }
+    }
+
+    if (pmem == (uint8_t*) MAP_FAILED) {
+        pmem = (uint8_t*) mmap(NULL, range.size(), PROT_READ | PROT_WRITE,
+                               map_flags, shm_fd, map_offset);
+    }
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
@@ -248,6 +326,8 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+    placeBackingStore(pmem, range, _memories, page_size);
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -262,6 +342,71 @@ PhysicalMemory::createBackingStore(
     }
 }
 
+void
+PhysicalMemory::placeBackingStore(
+        uint8_t *pmem, AddrRange range,
+        const std::vector<AbstractMemory*>& _memories, uint64_t page_size)
+{
+    if (hugePages == BackstoreHugePages::madvise) {
+#if defined(MADV_HUGEPAGE)
+        if (madvise(pmem, range.size(), MADV_HUGEPAGE))
+            warn("Could not advise huge pages for range %s: %s\n",
+                 range.to_string(), std::strerror(errno));
+#else
+        warn_once("Transparent huge pages are not supported on this host\n");
+#endif
+    }
+
+    if (!numaNodes.empty()) {
+        // bind the store to the node of the simulation thread of its
+        // memories, i.e., of their event queue
+        EventQueue *eventq = _memories.front()->eventQueue();
+        uint32_t index = 0;
+        while (index < numMainEventQueues && mainEventQueue[index] != eventq)
+            ++index;
+        int node = numaNodes[index % numaNodes.size()];
+
+        if (node >= 0) {
+            DPRINTF(AddrRanges, "Binding backing store for range %s to "
+                    "host NUMA node %d\n", range.to_string(), node);
+#if defined(__linux__) && defined(SYS_mbind)
+            // MPOL_BIND from the kernel's mempolicy.h, calling mbind
+            // directly rather than depending on libnuma
+            const int mpol_bind = 2;
+            const int bits = sizeof(unsigned long) * CHAR_BIT;
+            std::vector<unsigned long> node_mask(node / bits + 1, 0);
+            node_mask[node / bits] |= 1UL << (node % bits);
+            if (syscall(SYS_mbind, pmem, range.size(), mpol_bind,
+                        node_mask.data(), node_mask.size() * bits + 1, 0)) {
+                warn("Could not bind range %s to host NUMA node %d: %s\n",
+                     range.to_string(), node, std::strerror(errno));
+            }
+#else
+            warn_once("NUMA binding is not supported on this host\n");
+#endif
+        }
+    }
+
+    if (prefaultThreads) {
+        // write every page to fault it in, reading alone could map
+        // the shared zero page, keeping whatever is already there
+        uint64_t num_pages = divCeil(range.size(), page_size);
+        std::vector<std::thread> touchers;
+        for (unsigned t = 0; t < prefaultThreads; ++t) {
+            touchers.emplace_back([=]() {
+                uint64_t first = num_pages * t / prefaultThreads;
+                uint64_t last = num_pages * (t + 1) / prefaultThreads;
+                for (uint64_t p = first; p < last; ++p) {
+                    volatile uint8_t *byte = pmem + p * page_size;
+                    *byte = *byte;
+                }
+            });
+        }
+        for (auto &toucher : touchers)
+            toucher.join();
+    }
+}
+
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
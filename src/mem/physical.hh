@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/BackstoreHugePages.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,6 +159,17 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // How to back the memory with huge pages on the host
+    const BackstoreHugePages hugePages;
+
+    // Number of host threads touching the backing store when created,
+    // if any
+    const unsigned prefaultThreads;
+
+    // Host NUMA node per event queue, binding the backing store of
+    // memories in the queue to the node
+    const std::vector<int> numaNodes;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -174,7 +186,7 @@ class PhysicalMemory : public Serializable
      * the simulated system.
      *
      * @param range The address range covered
-     * @param memories The memories this range maps to
+     * @param _memories The memories this range maps to
      * @param kvm_map Should KVM map this memory for the guest
      */
     void createBackingStore(AddrRange range,
@@ -182,6 +194,20 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Apply the host placement options to a newly mapped backing
+     * store: advise huge pages, bind it to a NUMA node and fault it
+     * in.
+     *
+     * @param pmem The backing store
+     * @param range The address range covered
+     * @param _memories The memories this range maps to
+     * @param page_size Size of the pages the store is mapped with
+     */
+    void placeBackingStore(uint8_t *pmem, AddrRange range,
+                           const std::vector<AbstractMemory*>& _memories,
+                           uint64_t page_size);
+
   public:
 
     /**
@@ -191,7 +217,10 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   BackstoreHugePages huge_pages = BackstoreHugePages::none,
+                   unsigned prefault_threads = 0,
+                   const std::vector<int>& numa_nodes = {});
 
     /**
      * Unmap all the backing store we have used.
@@ -0,0 +1,50 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+
+from m5.objects.BaseMemProbe import BaseMemProbe
+
+
+class MemHeatmapProbe(BaseMemProbe):
+    type = "MemHeatmapProbe"
+    cxx_header = "mem/probes/mem_heatmap.hh"
+    cxx_class = "gem5::MemHeatmapProbe"
+
+    # accesses are counted per region in a count-min sketch, whose
+    # estimates exceed the actual count by at most e / sketch_width of
+    # all accesses, with a probability of 1 - exp(-sketch_depth)
+    region_size = Param.MemorySize("4KiB", "Granularity of the heatmap")
+    sketch_width = Param.Unsigned(4096, "Counters per row of the sketch")
+    sketch_depth = Param.Unsigned(4, "Rows of the sketch")
+    hot_regions = Param.Unsigned(64, "Hottest regions in a snapshot")
+
+    # the bandwidth timeline halves its resolution rather than growing
+    # beyond max_epochs
+    epoch = Param.Latency("10us", "Length of an epoch of the timeline")
+    max_epochs = Param.Unsigned(1024, "Epochs in a snapshot")
+
+    output_file = Param.String(
+        "", "Snapshot output file, defaults to <name>.heatmap"
+    )
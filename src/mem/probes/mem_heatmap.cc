@@ -0,0 +1,249 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/mem_heatmap.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/statistics.hh"
+#include "params/MemHeatmapProbe.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Identifies a file of heatmap snapshots, followed by the version and
+ * the tick frequency
+ */
+const char snapshotMagic[8] = {'g', 'e', 'm', '5', 'h', 'm', 'a', 'p'};
+const uint64_t snapshotVersion = 1;
+
+/** Check the parameters before the probe derives anything from them. */
+const MemHeatmapProbeParams &
+checkParams(const MemHeatmapProbeParams &p)
+{
+    fatal_if(!isPowerOf2(p.region_size),
+             "MemHeatmapProbe expects region size is power of 2");
+    fatal_if(!isPowerOf2(p.sketch_width) || p.sketch_width < 2,
+             "MemHeatmapProbe expects sketch width is power of 2, "
+             "and at least 2");
+    fatal_if(!p.sketch_depth, "MemHeatmapProbe needs at least one sketch row");
+    fatal_if(!p.hot_regions,
+             "MemHeatmapProbe needs to track at least one hot region");
+    fatal_if(!p.epoch || p.max_epochs < 2,
+             "MemHeatmapProbe needs epochs, and at least two of them");
+    return p;
+}
+
+} // anonymous namespace
+
+MemHeatmapProbe::MemHeatmapProbe(const MemHeatmapProbeParams &p)
+    : BaseMemProbe(checkParams(p)),
+      regionSizeLg2(floorLog2(p.region_size)),
+      sketchWidthLg2(floorLog2(p.sketch_width)),
+      sketchDepth(p.sketch_depth),
+      sketch(p.sketch_depth << sketchWidthLg2, 0),
+      numHotRegions(p.hot_regions),
+      baseEpochLength(p.epoch),
+      maxEpochs(p.max_epochs),
+      epochLength(p.epoch)
+{
+    // odd multipliers for the multiply-shift hashes, from splitmix64
+    uint64_t state = 0;
+    for (unsigned row = 0; row < sketchDepth; ++row) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        hashSeeds.push_back((z ^ (z >> 31)) | 1);
+    }
+
+    const std::string filename = p.output_file.empty() ?
+        name() + ".heatmap" : p.output_file;
+    snapshotStream = simout.create(filename, true, true);
+    snapshotStream->stream()->write(snapshotMagic, sizeof(snapshotMagic));
+    writeU64(snapshotVersion);
+    writeU64(sim_clock::Frequency);
+
+    statistics::registerDumpCallback([this]() { writeSnapshot(); });
+    statistics::registerResetCallback([this]() { clear(); });
+}
+
+void
+MemHeatmapProbe::handleRequest(const probing::PacketInfo &pi)
+{
+    if (!pi.cmd.isRequest() || !(pi.cmd.isRead() || pi.cmd.isWrite()))
+        return;
+
+    // count the region with a conservative update, only raising the
+    // counters that determine its estimate
+    const Addr region = pi.addr >> regionSizeLg2;
+    uint32_t count = std::numeric_limits<uint32_t>::max();
+    for (unsigned row = 0; row < sketchDepth; ++row)
+        count = std::min(count, counter(row, region));
+    if (count != std::numeric_limits<uint32_t>::max()) {
+        ++count;
+        for (unsigned row = 0; row < sketchDepth; ++row) {
+            uint32_t &c = counter(row, region);
+            c = std::max(c, count);
+        }
+    }
+    updateHot(region, count);
+    ++numAccesses;
+
+    const size_t idx = epochAt(curTick());
+    Epoch &epoch = epochs[idx];
+    if (pi.cmd.isRead())
+        epoch.bytesRead += pi.size;
+    else
+        epoch.bytesWritten += pi.size;
+}
+
+void
+MemHeatmapProbe::updateHot(Addr region, uint64_t count)
+{
+    auto it = hotRegions.find(region);
+    if (it != hotRegions.end()) {
+        // the threshold may now be too low, which only costs a look at
+        // the regions when the next candidate comes along
+        it->second = count;
+        return;
+    }
+
+    auto coldest = [this]() {
+        return std::min_element(hotRegions.begin(), hotRegions.end(),
+            [](const auto &a, const auto &b) { return a.second < b.second; });
+    };
+
+    if (hotRegions.size() < numHotRegions) {
+        hotRegions.emplace(region, count);
+        if (hotRegions.size() == numHotRegions)
+            hotThreshold = coldest()->second;
+        return;
+    }
+
+    if (count <= hotThreshold)
+        return;
+
+    auto victim = coldest();
+    if (victim->second < count) {
+        hotRegions.erase(victim);
+        hotRegions.emplace(region, count);
+        victim = coldest();
+    }
+    hotThreshold = victim->second;
+}
+
+size_t
+MemHeatmapProbe::epochAt(Tick when)
+{
+    size_t idx = (when - snapshotStart) / epochLength;
+    while (idx >= maxEpochs) {
+        // halve the resolution, merging neighbouring epochs
+        for (size_t i = 0; i < epochs.size(); i += 2) {
+            Epoch merged = epochs[i];
+            if (i + 1 < epochs.size()) {
+                merged.bytesRead += epochs[i + 1].bytesRead;
+                merged.bytesWritten += epochs[i + 1].bytesWritten;
+            }
+            epochs[i / 2] = merged;
+        }
+        epochs.resize(divCeil(epochs.size(), 2));
+        epochLength *= 2;
+        idx = (when - snapshotStart) / epochLength;
+    }
+
+    if (idx >= epochs.size())
+        epochs.resize(idx + 1);
+    return idx;
+}
+
+void
+MemHeatmapProbe::clear()
+{
+    std::fill(sketch.begin(), sketch.end(), 0);
+    hotRegions.clear();
+    hotThreshold = 0;
+    epochs.clear();
+    epochLength = baseEpochLength;
+    snapshotStart = curTick();
+    numAccesses = 0;
+}
+
+void
+MemHeatmapProbe::writeU64(uint64_t val)
+{
+    val = htole(val);
+    snapshotStream->stream()->write(reinterpret_cast<const char *>(&val),
+                                    sizeof(val));
+}
+
+void
+MemHeatmapProbe::writeSnapshot()
+{
+    // the timeline extends to now, even if nothing was seen lately
+    if (curTick() > snapshotStart)
+        epochAt(curTick() - 1);
+
+    std::vector<std::pair<Addr, uint64_t>> hot(hotRegions.begin(),
+                                               hotRegions.end());
+    std::sort(hot.begin(), hot.end(), [](const auto &a, const auto &b) {
+        return a.second > b.second || (a.second == b.second &&
+                                       a.first < b.first);
+    });
+
+    // a snapshot is a header and a column per field
+    writeU64(snapshotStart);
+    writeU64(curTick());
+    writeU64(1ULL << regionSizeLg2);
+    writeU64(numAccesses);
+
+    writeU64(epochLength);
+    writeU64(epochs.size());
+    for (const auto &epoch : epochs)
+        writeU64(epoch.bytesRead);
+    for (const auto &epoch : epochs)
+        writeU64(epoch.bytesWritten);
+
+    writeU64(hot.size());
+    for (const auto &region : hot)
+        writeU64(region.first << regionSizeLg2);
+    for (const auto &region : hot)
+        writeU64(region.second);
+
+    snapshotStream->stream()->flush();
+
+    clear();
+}
+
+} // namespace gem5
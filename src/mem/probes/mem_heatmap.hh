@@ -0,0 +1,131 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_MEM_HEATMAP_HH__
+#define __MEM_PROBES_MEM_HEATMAP_HH__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/output.hh"
+#include "mem/probes/base.hh"
+
+namespace gem5
+{
+
+struct MemHeatmapProbeParams;
+
+/**
+ * Probe keeping a heatmap of the accessed memory and a timeline of the
+ * bandwidth, in bounded space. Accesses are counted per region in a
+ * count-min sketch, which overestimates the count of a region by at
+ * most a fraction of all accesses with high probability, and the
+ * hottest regions are tracked alongside. The bandwidth is binned into
+ * epochs, which are merged pairwise when there are too many.
+ *
+ * A snapshot of the regions and the timeline since the previous one is
+ * written at every stats dump, see util/decode_mem_heatmap.py for the
+ * format.
+ */
+class MemHeatmapProbe : public BaseMemProbe
+{
+  public:
+    MemHeatmapProbe(const MemHeatmapProbeParams &p);
+
+    /** Forget what was seen, e.g., at a stats reset */
+    void clear();
+
+    /** Write a snapshot of what was seen since the last one, and clear */
+    void writeSnapshot();
+
+  protected:
+    void handleRequest(const probing::PacketInfo &pkt_info) override;
+
+    /** Region size (log2) */
+    const uint8_t regionSizeLg2;
+
+    /** Counters per row of the sketch (log2), and rows */
+    const uint8_t sketchWidthLg2;
+    const unsigned sketchDepth;
+
+    /** Saturating counters, row after row */
+    std::vector<uint32_t> sketch;
+
+    /** Multiply-shift hash of every row */
+    std::vector<uint64_t> hashSeeds;
+
+    /** Counter of a region in a row of the sketch */
+    uint32_t &
+    counter(unsigned row, Addr region)
+    {
+        const uint64_t col = (region * hashSeeds[row]) >>
+            (64 - sketchWidthLg2);
+        return sketch[(row << sketchWidthLg2) + col];
+    }
+
+    /** The hottest regions, with their estimated counts */
+    const unsigned numHotRegions;
+    std::unordered_map<Addr, uint64_t> hotRegions;
+    /** Smallest count among the hottest regions, if all are known */
+    uint64_t hotThreshold = 0;
+
+    /** Keep track of a region among the hottest, if it is one */
+    void updateHot(Addr region, uint64_t count);
+
+    struct Epoch
+    {
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    /** The timeline since the snapshot started, and its resolution */
+    const Tick baseEpochLength;
+    const unsigned maxEpochs;
+    Tick epochLength;
+    Tick snapshotStart = 0;
+    std::vector<Epoch> epochs;
+
+    /**
+     * Make the timeline cover a point in time, halving its resolution
+     * as needed
+     *
+     * @param when The point in time, not before the snapshot started
+     * @return Index of the epoch it falls in
+     */
+    size_t epochAt(Tick when);
+
+    /** Accesses since the snapshot started */
+    uint64_t numAccesses = 0;
+
+    OutputStream *snapshotStream;
+
+    /** Write a value to the snapshots, in little endian */
+    void writeU64(uint64_t val);
+};
+
+} // namespace gem5
+
+#endif  //__MEM_PROBES_MEM_HEATMAP_HH__
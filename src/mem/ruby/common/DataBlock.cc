@@ -40,6 +40,11 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <new>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/logging.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -49,39 +54,97 @@ namespace gem5
 namespace ruby
 {
 
-DataBlock::DataBlock(const DataBlock &cp)
+DataBlock::Line *DataBlock::s_zero_line = nullptr;
+uint32_t DataBlock::s_zero_line_size = 0;
+
+DataBlock::Line *
+DataBlock::zeroLine()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
+    uint32_t size = RubySystem::getBlockSizeBytes();
+    if (GEM5_LIKELY(s_zero_line && size <= s_zero_line_size))
+        return s_zero_line;
+
+    // Blocks already on the zero line never take a reference to it, so
+    // it cannot be replaced once handed out.
+    panic_if(s_zero_line, "Ruby block size changed from %d to %d after "
+             "data blocks were created\n", s_zero_line_size, size);
+    s_zero_line = allocLine();
+    memset(s_zero_line->data(), 0, size);
+    s_zero_line_size = size;
+    return s_zero_line;
 }
 
-void
-DataBlock::alloc()
+DataBlock::Line *
+DataBlock::allocLine()
+{
+    void *mem = ::operator new(sizeof(Line) +
+                               RubySystem::getBlockSizeBytes());
+    Line *line = new (mem) Line;
+    line->refs.store(1, std::memory_order_relaxed);
+    return line;
+}
+
+uint8_t *
+DataBlock::copyOnWrite()
+{
+    if (RubySystem::getElideData()) {
+        // Nothing reads the data back, so writes go to a scratch line
+        // and every block stays on the zero line.
+        static thread_local std::vector<uint8_t> scratch;
+        scratch.resize(RubySystem::getBlockSizeBytes());
+        return scratch.data();
+    }
+
+    Line *line = allocLine();
+    memcpy(line->data(), m_data, RubySystem::getBlockSizeBytes());
+    release();
+    m_line = line;
+    m_data = line->data();
+    return m_data;
+}
+
+DataBlock::DataBlock(const DataBlock &cp)
+    : m_line(cp.m_line), m_data(cp.m_data)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    if (!m_line && RubySystem::getElideData()) {
+        m_line = zeroLine();
+        m_data = m_line->data();
+    } else if (!m_line) {
+        // Assigned storage can change under us, so take a private copy
+        m_line = allocLine();
+        m_data = m_line->data();
+        memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
+    } else if (m_line != s_zero_line) {
+        m_line->refs.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void
 DataBlock::clear()
 {
-    memset(m_data, 0, RubySystem::getBlockSizeBytes());
+    if (!m_line) {
+        memset(m_data, 0, RubySystem::getBlockSizeBytes());
+    } else {
+        release();
+        m_line = zeroLine();
+        m_data = m_line->data();
+    }
 }
 
 bool
 DataBlock::equal(const DataBlock& obj) const
 {
-    return !memcmp(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    return m_data == obj.m_data ||
+        !memcmp(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
 }
 
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
+    uint8_t *data = writableData();
     for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
         if (mask.getMask(i, 1)) {
-            m_data[i] = dblk.m_data[i];
+            data[i] = dblk.m_data[i];
         }
     }
 }
@@ -89,10 +152,11 @@ DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask)
 {
+    uint8_t *data = writableData();
     for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        m_data[i] = dblk.m_data[i];
+        data[i] = dblk.m_data[i];
     }
-    mask.performAtomic(m_data);
+    mask.performAtomic(data);
 }
 
 void
@@ -117,13 +181,13 @@ DataBlock::getData(int offset, int len) const
 uint8_t*
 DataBlock::getDataMod(int offset)
 {
-    return &m_data[offset];
+    return &writableData()[offset];
 }
 
 void
 DataBlock::setData(const uint8_t *data, int offset, int len)
 {
-    memcpy(&m_data[offset], data, len);
+    memcpy(&writableData()[offset], data, len);
 }
 
 void
@@ -131,13 +195,25 @@ DataBlock::setData(PacketPtr pkt)
 {
     int offset = getOffset(pkt->getAddr());
     assert(offset + pkt->getSize() <= RubySystem::getBlockSizeBytes());
-    pkt->writeData(&m_data[offset]);
+    pkt->writeData(&writableData()[offset]);
 }
 
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
-    memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    if (!m_line || !obj.m_line) {
+        // Assigned storage is written through and never shared
+        if (m_data != obj.m_data) {
+            memcpy(writableData(), obj.m_data,
+                   RubySystem::getBlockSizeBytes());
+        }
+    } else if (m_line != obj.m_line) {
+        if (obj.m_line != s_zero_line)
+            obj.m_line->refs.fetch_add(1, std::memory_order_relaxed);
+        release();
+        m_line = obj.m_line;
+        m_data = obj.m_data;
+    }
     return *this;
 }
 
@@ -43,6 +43,7 @@
 
 #include <inttypes.h>
 
+#include <atomic>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
@@ -57,20 +58,28 @@ namespace ruby
 
 class WriteMask;
 
+/**
+ * A cache line worth of data. Copies of a block share the same storage
+ * until one of them is written (copy on write), and blocks that have
+ * never been written all share a single zero line, so carrying data in
+ * messages and TBEs only costs a reference count update.
+ *
+ * When the RubySystem does not track data (see RubySystem::getElideData)
+ * every block stays on the zero line and writes are discarded.
+ */
 class DataBlock
 {
   public:
     DataBlock()
+        : m_line(zeroLine()), m_data(m_line->data())
     {
-        alloc();
     }
 
     DataBlock(const DataBlock &cp);
 
     ~DataBlock()
     {
-        if (m_alloc)
-            delete [] m_data;
+        release();
     }
 
     DataBlock& operator=(const DataBlock& obj);
@@ -91,20 +100,61 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
-    void alloc();
+    /**
+     * Reference counted storage of one line. The bytes of the line are
+     * allocated right after it.
+     */
+    struct Line
+    {
+        std::atomic<uint32_t> refs;
+
+        uint8_t *data() { return reinterpret_cast<uint8_t *>(this + 1); }
+    };
+
+    static Line *zeroLine();
+    static Line *allocLine();
+
+    /** Drop the reference to the current line. */
+    void
+    release()
+    {
+        if (m_line && m_line != s_zero_line &&
+            m_line->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_line->~Line();
+            ::operator delete(m_line);
+        }
+    }
+
+    /** Storage that may be written, copying a shared line first. */
+    uint8_t *
+    writableData()
+    {
+        if (m_line && (m_line == s_zero_line ||
+                       m_line->refs.load(std::memory_order_acquire) > 1)) {
+            return copyOnWrite();
+        }
+        return m_data;
+    }
+
+    uint8_t *copyOnWrite();
+
+    /** The line shared by all blocks that hold only zeros. */
+    static Line *s_zero_line;
+    /** Number of bytes in s_zero_line. */
+    static uint32_t s_zero_line_size;
+
+    /** Storage of m_data; nullptr if it was assigned from outside. */
+    Line *m_line;
     uint8_t *m_data;
-    bool m_alloc;
 };
 
 inline void
 DataBlock::assign(uint8_t *data)
 {
     assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
+    release();
     m_data = data;
-    m_alloc = false;
+    m_line = nullptr;
 }
 
 inline uint8_t
@@ -116,7 +166,7 @@ DataBlock::getByte(int whichByte) const
 inline void
 DataBlock::setByte(int whichByte, uint8_t data)
 {
-    m_data[whichByte] = data;
+    writableData()[whichByte] = data;
 }
 
 inline void
@@ -31,10 +31,15 @@
 
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <deque>
+#include <set>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
+#include "base/random.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
@@ -74,12 +79,28 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_routing_algorithm = p.routing_algorithm;
     m_next_packet_id = 0;
     m_is_dragonfly = p.is_dragonfly;
+    m_partitioned = false;
+    m_partition_lookahead = MaxTick;
+    m_fast_mode = p.fast_mode;
+    m_hop_cycles = 1;
+    m_latency_scale = 1;
+    m_calib_model_cycles = 0;
+    m_calib_measured_cycles = 0;
+    m_utilization_window = p.fast_utilization_window;
+    fatal_if(m_utilization_window == 0,
+             "%s: fast_utilization_window must be at least one cycle\n",
+             name());
+    m_window_start = 0;
+    m_window_flits = 0;
+    m_utilization = 0;
 
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
         fault_model = p.fault_model;
 
     m_vnet_type.resize(m_virtual_networks);
+    m_packets_in_flight.resize(m_virtual_networks, 0);
+    m_fast_last_arrival.resize(m_virtual_networks, 0);
 
     for (int i = 0 ; i < m_virtual_networks ; i++) {
         if (m_vnet_type_names[i] == "response")
@@ -97,6 +118,7 @@ GarnetNetwork::GarnetNetwork(const Params &p)
         // initialize the router's network pointers
         router->init_net_ptr(this);
     }
+    m_router_adjacency.resize(m_routers.size());
 
     // record the network interfaces
     for (std::vector<ClockedObject*>::const_iterator i = p.netifs.begin();
@@ -124,6 +146,9 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    setupPartitions();
+    setupFastMode();
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
@@ -167,6 +192,254 @@ GarnetNetwork::init()
     }
 }
 
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+
+    if (m_partitioned) {
+        m_partition_exchange = std::make_unique<PartitionExchangeEvent>(
+            this, curTick() + m_partition_lookahead, m_partition_lookahead);
+    }
+}
+
+/*
+ * Routers, NIs and links are assigned to event queues through their
+ * eventq_index parameter (see configs/network/Network.py). A link always
+ * runs on the queue of the object feeding it. If its consumer sits on
+ * another queue, the link crosses partitions: its flits are staged and
+ * handed over at the next exchange. Exchanges are spaced by the smallest
+ * latency among those links, so a staged flit always reaches its consumer
+ * before the cycle it is due there, as in a single-queue run.
+ */
+void
+GarnetNetwork::setupPartitions()
+{
+    std::vector<NetworkLink *> links(m_networklinks);
+    links.insert(links.end(), m_creditlinks.begin(), m_creditlinks.end());
+
+    std::set<EventQueue *> queues;
+    for (auto link : links) {
+        ClockedObject *src = link->getSourceObject();
+        Consumer *consumer = link->getLinkConsumer();
+        if (src == nullptr || consumer == nullptr)
+            continue;
+
+        ClockedObject *dst = consumer->getObject();
+        queues.insert(src->eventQueue());
+        queues.insert(dst->eventQueue());
+
+        fatal_if(link->eventQueue() != src->eventQueue(),
+                 "%s: link must share the event queue of its source %s\n",
+                 link->name(), src->name());
+
+        if (dst->eventQueue() == src->eventQueue())
+            continue;
+
+        link->setCrossesPartition(true);
+        m_partition_links.push_back(link);
+        m_partition_lookahead = std::min(m_partition_lookahead,
+            link->cyclesToTicks(Cycles(link->get_latency())));
+    }
+
+    if (m_partition_links.empty())
+        return;
+
+    fatal_if(!m_networkbridges.empty(),
+             "%s: CDC/SerDes bridges are not supported when the network "
+             "spans several event queues\n", name());
+    fatal_if(m_partition_lookahead == 0,
+             "%s: links crossing partitions need a non-zero latency\n",
+             name());
+
+    m_partitioned = true;
+
+    // Routing decisions must not depend on thread interleaving, so each
+    // router draws from its own generator. The seeds are taken here,
+    // while still single-threaded, to keep runs reproducible.
+    for (auto router : m_routers)
+        router->setPrivateRandom(random_mt.random<uint32_t>());
+
+    inform("%s: %d partitions, %d links crossing partitions, "
+           "exchange every %d ticks\n", name(), queues.size(),
+           m_partition_links.size(), m_partition_lookahead);
+}
+
+/*
+ * All event queues wait on the barrier while this runs. Deliver the staged
+ * flits and credits on behalf of their consumers, switching to the
+ * consumer's queue so that its wakeups are scheduled there directly.
+ */
+void
+GarnetNetwork::exchangePartitionTraffic()
+{
+    EventQueue *cur_q = curEventQueue();
+    for (auto link : m_partition_links) {
+        curEventQueue(link->getLinkConsumer()->getObject()->eventQueue());
+        link->deliverStagedFlits();
+    }
+    curEventQueue(cur_q);
+}
+
+void
+GarnetNetwork::PartitionExchangeEvent::process()
+{
+    m_net->exchangePartitionTraffic();
+    GlobalSyncEvent::process();
+}
+
+const char *
+GarnetNetwork::PartitionExchangeEvent::description() const
+{
+    return "GarnetNetwork partition exchange";
+}
+
+std::unique_lock<std::mutex>
+GarnetNetwork::lockStats()
+{
+    if (!m_partitioned)
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(m_stats_mutex);
+}
+
+/*
+ * The fast mode latency model. Hop counts are the shortest paths over
+ * the internal links; the per-hop latency starts from the configured
+ * router and link latencies.
+ */
+void
+GarnetNetwork::setupFastMode()
+{
+    int num_routers = m_routers.size();
+    m_router_distance.assign(num_routers * num_routers, num_routers);
+    for (int src = 0; src < num_routers; src++) {
+        int *dist = &m_router_distance[src * num_routers];
+        std::deque<int> frontier{src};
+        dist[src] = 0;
+        while (!frontier.empty()) {
+            int router = frontier.front();
+            frontier.pop_front();
+            for (int next : m_router_adjacency[router]) {
+                if (dist[next] > dist[router] + 1) {
+                    dist[next] = dist[router] + 1;
+                    frontier.push_back(next);
+                }
+            }
+        }
+    }
+
+    double router_cycles = 0;
+    for (auto router : m_routers)
+        router_cycles += router->get_pipe_stages();
+    router_cycles /= std::max(num_routers, 1);
+
+    double link_cycles = 0;
+    int num_int_links = 0;
+    for (auto link : m_networklinks) {
+        if (link->getType() == INT_) {
+            link_cycles += link->get_latency();
+            num_int_links++;
+        }
+    }
+    link_cycles /= std::max(num_int_links, 1);
+
+    m_hop_cycles = router_cycles + link_cycles;
+
+    setFastMode(m_fast_mode);
+    m_vnet_fast.assign(m_virtual_networks, m_fast_mode);
+}
+
+void
+GarnetNetwork::setFastMode(bool fast)
+{
+    fatal_if(fast && m_partitioned,
+             "%s: the fast mode cannot be used when the network spans "
+             "several event queues\n", name());
+
+    if (fast && !m_fast_mode && m_calib_model_cycles > 0) {
+        m_latency_scale = m_calib_measured_cycles / m_calib_model_cycles;
+        m_calib_model_cycles = 0;
+        m_calib_measured_cycles = 0;
+    }
+
+    if (fast != m_fast_mode) {
+        inform("%s: switching to %s mode at tick %d (latency scale %.3f)\n",
+               name(), fast ? "fast" : "detailed", curTick(),
+               m_latency_scale);
+    }
+    m_fast_mode = fast;
+}
+
+bool
+GarnetNetwork::getVnetMode(int vnet, bool &fast)
+{
+    if (m_vnet_fast[vnet] != m_fast_mode) {
+        bool drained = m_vnet_fast[vnet] ?
+            curTick() >= m_fast_last_arrival[vnet] :
+            m_packets_in_flight[vnet] == 0;
+        if (!drained)
+            return false;
+        m_vnet_fast[vnet] = m_fast_mode;
+    }
+    fast = m_vnet_fast[vnet];
+    return true;
+}
+
+/*
+ * Zero-load latency is one router pipeline and link per hop, plus one
+ * cycle per extra flit. Each hop is stretched by the mean M/D/1 waiting
+ * time rho / (2 * (1 - rho)) at the recent injection rate rho.
+ */
+double
+GarnetNetwork::fastModelCycles(int src_router, int dest_router,
+                               int num_flits)
+{
+    int hops = m_router_distance[src_router * m_routers.size() +
+                                 dest_router] + 1;
+    double rho = std::min(injectionUtilization(), 0.95);
+    double hop_cycles = m_hop_cycles * (1.0 + rho / (2.0 * (1.0 - rho)));
+    return hops * hop_cycles + (num_flits - 1);
+}
+
+Tick
+GarnetNetwork::fastModeLatency(int src_router, int dest_router,
+                               int num_flits)
+{
+    double cycles = m_latency_scale *
+        fastModelCycles(src_router, dest_router, num_flits);
+    return cyclesToTicks(Cycles(std::max<uint64_t>(1, std::llround(cycles))));
+}
+
+void
+GarnetNetwork::fastModeSent(int vnet, Tick arrival)
+{
+    m_fast_last_arrival[vnet] = std::max(m_fast_last_arrival[vnet], arrival);
+}
+
+// Detailed-mode packets feed the latency scale used by the fast mode
+void
+GarnetNetwork::calibrateFastMode(int src_router, int dest_router,
+                                 int num_flits, Tick latency)
+{
+    m_calib_model_cycles +=
+        fastModelCycles(src_router, dest_router, num_flits);
+    m_calib_measured_cycles += double(latency) / clockPeriod();
+}
+
+double
+GarnetNetwork::injectionUtilization()
+{
+    Tick window_end = m_window_start + cyclesToTicks(m_utilization_window);
+    if (curTick() >= window_end) {
+        Cycles elapsed = ticksToCycles(curTick() - m_window_start);
+        m_utilization = double(m_window_flits) /
+            (double(elapsed) * std::max<size_t>(m_nis.size(), 1));
+        m_window_start = curTick();
+        m_window_flits = 0;
+    }
+    return m_utilization;
+}
+
 /*
  * This function creates a link from the Network Interface (NI)
  * into the Network.
@@ -333,6 +606,7 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    m_router_adjacency[src].push_back(dest);
 
     m_max_vcs_per_vnet = std::max(m_max_vcs_per_vnet,
                              std::max(m_routers[dest]->get_vc_per_vnet(),
@@ -396,6 +670,15 @@ GarnetNetwork::get_router_id(int global_ni, int vnet)
     return m_nis[local_ni]->get_router_id(vnet);
 }
 
+NetworkInterface *
+GarnetNetwork::getNetworkInterface(NodeID global_ni)
+{
+    NodeID local_ni = getLocalNodeID(global_ni);
+    assert(local_ni < m_nis.size());
+
+    return m_nis[local_ni];
+}
+
 void
 GarnetNetwork::regStats()
 {
@@ -558,6 +841,12 @@ GarnetNetwork::regStats()
         ;
     m_avg_hops = m_total_hops / sum(m_flits_received);
 
+    // Fast mode
+    m_fast_packets
+        .name(name() + ".fast_mode_packets")
+        .unit(statistics::units::Packets::get())
+        ;
+
     // Links
     m_total_ext_in_link_utilization
         .name(name() + ".ext_in_link_utilization");
@@ -649,7 +938,7 @@ GarnetNetwork::print(std::ostream& out) const
 }
 
 void
-GarnetNetwork::update_traffic_distribution(RouteInfo route)
+GarnetNetwork::update_traffic_distribution(const RouteInfo &route)
 {
     int src_node = route.src_router;
     int dest_node = route.dest_router;
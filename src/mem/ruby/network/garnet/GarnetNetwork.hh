@@ -33,12 +33,15 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "params/GarnetNetwork.hh"
+#include "sim/global_event.hh"
 
 namespace gem5
 {
@@ -184,6 +187,7 @@ class GarnetNetwork : public Network
     ~GarnetNetwork() = default;
 
     void init();
+    void startup();
 
     const char *garnetVersion = "3.0";
 
@@ -283,10 +287,54 @@ class GarnetNetwork : public Network
         m_total_hops += hops;
     }
 
-    void update_traffic_distribution(RouteInfo route);
+    void update_traffic_distribution(const RouteInfo &route);
     int getNextPacketID() { return m_next_packet_id++; }
     bool isDragonfly() { return m_is_dragonfly; }
 
+    // Partitioned simulation. Routers and NIs may be spread over several
+    // event queues (one host thread each) through their eventq_index.
+    // Links whose two ends sit on different queues stage their flits and
+    // credits, which are exchanged at barriers spaced by the smallest
+    // latency of such a link.
+    bool isPartitioned() const { return m_partitioned; }
+    Tick getPartitionLookahead() const { return m_partition_lookahead; }
+    int getNumNIs() const { return m_nis.size(); }
+
+    // Network-wide counters are shared by all partitions; NIs hold this
+    // lock while updating them. It does not lock anything when the
+    // network runs on a single event queue.
+    std::unique_lock<std::mutex> lockStats();
+
+    // Analytical fast mode. Messages bypass the routers and links and are
+    // put straight into the destination's protocol buffer. Their latency
+    // is the router hop count times a per-hop latency, inflated by a
+    // queueing estimate from the recent injection rate, plus
+    // serialization. The per-hop latency is calibrated against the
+    // packets delivered in detailed mode. The mode can be changed from
+    // Python between simulate() calls, e.g. after m5.drain().
+    void setFastMode(bool fast);
+    bool isFastMode() const { return m_fast_mode; }
+
+    // Mode the next message on vnet is sent in. Returns false while the
+    // vnet is still switching modes: it only follows the requested mode
+    // once the messages sent in the old mode have left the network, so
+    // that deliveries are never reordered. Meanwhile its messages wait
+    // in the protocol buffers.
+    bool getVnetMode(int vnet, bool &fast);
+
+    Tick fastModeLatency(int src_router, int dest_router, int num_flits);
+    void fastModeSent(int vnet, Tick arrival);
+    void calibrateFastMode(int src_router, int dest_router, int num_flits,
+                           Tick latency);
+    void recordInjection(int num_flits) { m_window_flits += num_flits; }
+
+    void packetInjected(int vnet) { m_packets_in_flight[vnet]++; }
+    void packetEjected(int vnet) { m_packets_in_flight[vnet]--; }
+
+    void increment_fast_packets() { m_fast_packets++; }
+
+    NetworkInterface *getNetworkInterface(NodeID global_ni);
+
   protected:
     // Configuration
     int m_num_rows;
@@ -334,6 +382,8 @@ class GarnetNetwork : public Network
     statistics::Scalar  m_total_hops;
     statistics::Formula m_avg_hops;
 
+    statistics::Scalar m_fast_packets;
+
     std::vector<std::vector<statistics::Scalar *>> m_data_traffic_distribution;
     std::vector<std::vector<statistics::Scalar *>> m_ctrl_traffic_distribution;
 
@@ -341,6 +391,28 @@ class GarnetNetwork : public Network
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    class PartitionExchangeEvent : public GlobalSyncEvent
+    {
+      public:
+        PartitionExchangeEvent(GarnetNetwork *net, Tick when, Tick period)
+            : GlobalSyncEvent(when, period, Event::Minimum_Pri, 0),
+              m_net(net)
+        {}
+
+        void process() override;
+        const char *description() const override;
+
+      private:
+        GarnetNetwork *m_net;
+    };
+
+    void setupPartitions();
+    void exchangePartitionTraffic();
+
+    void setupFastMode();
+    double fastModelCycles(int src_router, int dest_router, int num_flits);
+    double injectionUtilization();
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
@@ -348,6 +420,35 @@ class GarnetNetwork : public Network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
     int m_next_packet_id; // static vairable for packet id allocation
+
+    bool m_partitioned;
+    Tick m_partition_lookahead;
+    // Links whose consumer runs on a different event queue
+    std::vector<NetworkLink *> m_partition_links;
+    std::unique_ptr<PartitionExchangeEvent> m_partition_exchange;
+    std::mutex m_stats_mutex;
+
+    bool m_fast_mode;
+    // Mode each vnet currently delivers in
+    std::vector<bool> m_vnet_fast;
+    // Detailed-mode packets injected but not yet ejected, per vnet
+    std::vector<int> m_packets_in_flight;
+    // Latest arrival of a fast-mode message, per vnet
+    std::vector<Tick> m_fast_last_arrival;
+
+    // Latency model
+    std::vector<std::vector<int>> m_router_adjacency;
+    std::vector<int> m_router_distance; // routers x routers, in links
+    double m_hop_cycles;
+    double m_latency_scale;
+    double m_calib_model_cycles;
+    double m_calib_measured_cycles;
+
+    // Injection rate over the last window, in flits per NI per cycle
+    Cycles m_utilization_window;
+    Tick m_window_start;
+    uint64_t m_window_flits;
+    double m_utilization;
 };
 
 inline std::ostream&
@@ -30,6 +30,7 @@
 
 from m5.params import *
 from m5.proxy import *
+from m5.util.pybind import PyBindMethod
 from m5.objects.Network import RubyNetwork
 from m5.objects.BasicRouter import BasicRouter
 from m5.objects.ClockedObject import ClockedObject
@@ -54,6 +55,18 @@ class GarnetNetwork(RubyNetwork):
         50000, "network-level deadlock threshold"
     )
     is_dragonfly = Param.Bool(False, "whether the topology is dragonfly")
+    fast_mode = Param.Bool(
+        False,
+        "start in the analytical fast mode, which delivers messages "
+        "after a modelled latency instead of simulating flits",
+    )
+    fast_utilization_window = Param.Cycles(
+        1000,
+        "window over which the injection rate feeding the fast mode "
+        "queueing estimate is measured",
+    )
+
+    cxx_exports = [PyBindMethod("setFastMode")]
 
 
 class GarnetNetworkInterface(ClockedObject):
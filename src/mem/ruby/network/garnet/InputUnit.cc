@@ -103,7 +103,7 @@ InputUnit::wakeup()
             // The output port field in the flit is updated after it wins SA
 
             if (m_router->get_net_ptr()->isDragonfly()) {
-                RouteInfo route = t_flit->get_route();
+                const RouteInfo &route = t_flit->get_route();
                 int routers_per_group = m_router->get_net_ptr()->getRoutersPerGroup();
                 int group_cur = int(m_router->get_id() / routers_per_group);
                 int group_src = int(route.src_router / routers_per_group);
@@ -32,6 +32,7 @@
 
 #include "mem/ruby/network/garnet/NetworkInterface.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -54,7 +55,7 @@ namespace garnet
 NetworkInterface::NetworkInterface(const Params &p)
   : ClockedObject(p), Consumer(this), m_id(p.id),
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
-    m_vc_allocator(m_virtual_networks, 0),
+    m_vc_allocator(m_virtual_networks, 0), m_packets_flitisized(0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
     vc_busy_counter(m_virtual_networks, 0)
 {
@@ -132,6 +133,7 @@ NetworkInterface::addNode(std::vector<MessageBuffer *>& in,
 {
     inNode_ptr = in;
     outNode_ptr = out;
+    m_fast_last_arrival.resize(out.size(), 0);
 
     for (auto& it : in) {
         if (it != nullptr) {
@@ -154,6 +156,7 @@ void
 NetworkInterface::incrementStats(flit *t_flit)
 {
     int vnet = t_flit->get_vnet();
+    auto stats_lock = m_net_ptr->lockStats();
 
     // Latency
     m_net_ptr->increment_received_flits(vnet);
@@ -171,6 +174,11 @@ NetworkInterface::incrementStats(flit *t_flit)
         m_net_ptr->increment_received_packets(vnet);
         m_net_ptr->increment_packet_network_latency(network_delay, vnet);
         m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->packetEjected(vnet);
+
+        const RouteInfo &route = t_flit->get_route();
+        m_net_ptr->calibrateFastMode(route.src_router, route.dest_router,
+                                     t_flit->get_size(), network_delay);
     }
 
     // Hops
@@ -210,8 +218,14 @@ NetworkInterface::wakeup()
         }
 
         if (b->isReady(curTime)) { // Is there a message waiting
+            // Messages wait while their vnet switches modes
+            bool fast;
+            if (!m_net_ptr->getVnetMode(vnet, fast))
+                continue;
+
             msg_ptr = b->peekMsgPtr();
-            if (flitisizeMessage(msg_ptr, vnet)) {
+            if (fast ? deliverMessage(msg_ptr, vnet) :
+                       flitisizeMessage(msg_ptr, vnet)) {
                 b->dequeue(curTime);
             }
         }
@@ -399,18 +413,8 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
         if (dest_nodes.size() > 1) {
-            NetDest personal_dest;
-            for (int m = 0; m < (int) MachineType_NUM; m++) {
-                if ((destID >= MachineType_base_number((MachineType) m)) &&
-                    destID < MachineType_base_number((MachineType) (m+1))) {
-                    // calculating the NetDest associated with this destID
-                    personal_dest.clear();
-                    personal_dest.add((MachineID) {(MachineType) m, (destID -
-                        MachineType_base_number((MachineType) m))});
-                    new_net_msg_ptr->getDestination() = personal_dest;
-                    break;
-                }
-            }
+            NetDest personal_dest = nodeDestination(destID);
+            new_net_msg_ptr->getDestination() = personal_dest;
             net_msg_dest.removeNetDest(personal_dest);
             // removing the destination from the original message to reflect
             // that a message with this particular destination has been
@@ -434,9 +438,17 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // so that the first router increments it to 0
         route.hops_traversed = -1;
 
+        auto stats_lock = m_net_ptr->lockStats();
         m_net_ptr->increment_injected_packets(vnet);
         m_net_ptr->update_traffic_distribution(route);
-        int packet_id = m_net_ptr->getNextPacketID();
+        m_net_ptr->packetInjected(vnet);
+        m_net_ptr->recordInjection(num_flits);
+
+        // Packet ids only need to be unique. In a partitioned network each
+        // NI numbers its own packets so ids do not depend on thread order.
+        int packet_id = m_net_ptr->isPartitioned() ?
+            m_id + m_net_ptr->getNumNIs() * m_packets_flitisized++ :
+            m_net_ptr->getNextPacketID();
         for (int i = 0; i < num_flits; i++) {
             m_net_ptr->increment_injected_flits(vnet);
             flit *fl = new flit(packet_id,
@@ -455,6 +467,78 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     return true ;
 }
 
+// Fast mode: hand the message to each destination's protocol buffer,
+// after the latency given by the network's model, instead of
+// flitisizing it.
+bool
+NetworkInterface::deliverMessage(MsgPtr msg_ptr, int vnet)
+{
+    Message *net_msg_ptr = msg_ptr.get();
+    std::vector<NodeID> dest_nodes =
+        net_msg_ptr->getDestination().getAllDest();
+
+    OutputPort *oPort = getOutportForVnet(vnet);
+    assert(oPort);
+    int num_flits = (int)divCeil((float) m_net_ptr->MessageSizeType_to_int(
+        net_msg_ptr->getMessageSize()), (float)oPort->bitWidth());
+
+    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
+        NodeID destID = dest_nodes[ctr];
+        NetworkInterface *dest_ni = m_net_ptr->getNetworkInterface(destID);
+        MessageBuffer *dest_buffer = dest_ni->outNode_ptr[vnet];
+
+        // Destinations already served have been removed from the message
+        if (!dest_buffer->areNSlotsAvailable(1, curTick()))
+            return false;
+
+        MsgPtr new_msg_ptr = msg_ptr->clone();
+        if (dest_nodes.size() > 1) {
+            NetDest personal_dest = nodeDestination(destID);
+            new_msg_ptr->getDestination() = personal_dest;
+            net_msg_ptr->getDestination().removeNetDest(personal_dest);
+        }
+
+        int src_router = oPort->routerID();
+        int dest_router = m_net_ptr->get_router_id(destID, vnet);
+        Tick latency = m_net_ptr->fastModeLatency(src_router, dest_router,
+                                                  num_flits);
+
+        // Keep the deliveries into each protocol buffer in order
+        Tick arrival = std::max(curTick() + latency,
+                                dest_ni->m_fast_last_arrival[vnet]);
+        dest_ni->m_fast_last_arrival[vnet] = arrival;
+        dest_buffer->enqueue(new_msg_ptr, curTick(), arrival - curTick());
+        m_net_ptr->fastModeSent(vnet, arrival);
+
+        m_net_ptr->recordInjection(num_flits);
+        m_net_ptr->increment_injected_packets(vnet);
+        m_net_ptr->increment_received_packets(vnet);
+        m_net_ptr->increment_packet_network_latency(arrival - curTick(),
+                                                    vnet);
+        m_net_ptr->increment_packet_queueing_latency(
+            curTick() - msg_ptr->getTime(), vnet);
+        m_net_ptr->increment_fast_packets();
+    }
+    return true;
+}
+
+// NetDest holding just the given node
+NetDest
+NetworkInterface::nodeDestination(NodeID destID)
+{
+    NetDest personal_dest;
+    for (int m = 0; m < (int) MachineType_NUM; m++) {
+        if ((destID >= MachineType_base_number((MachineType) m)) &&
+            destID < MachineType_base_number((MachineType) (m+1))) {
+            // calculating the NetDest associated with this destID
+            personal_dest.add((MachineID) {(MachineType) m, (destID -
+                MachineType_base_number((MachineType) m))});
+            break;
+        }
+    }
+    return personal_dest;
+}
+
 // Looking for a free output vc
 int
 NetworkInterface::calculateVC(int vnet)
@@ -274,6 +274,7 @@ class NetworkInterface : public ClockedObject, public Consumer
     const int m_virtual_networks;
     int m_vc_per_vnet;
     std::vector<int> m_vc_allocator;
+    int m_packets_flitisized;
     std::vector<OutputPort *> outPorts;
     std::vector<InputPort *> inPorts;
     int m_deadlock_threshold;
@@ -290,11 +291,15 @@ class NetworkInterface : public ClockedObject, public Consumer
     std::vector<MessageBuffer *> inNode_ptr;
     // The Message buffers that provides messages to the protocol
     std::vector<MessageBuffer *> outNode_ptr;
+    // Latest fast-mode arrival into each of the protocol buffers above
+    std::vector<Tick> m_fast_last_arrival;
     // When a vc stays busy for a long time, it indicates a deadlock
     std::vector<int> vc_busy_counter;
 
     void checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
+    bool deliverMessage(MsgPtr msg_ptr, int vnet);
+    NetDest nodeDestination(NodeID destID);
     int calculateVC(int vnet);
 
 
@@ -48,7 +48,8 @@ namespace garnet
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
       m_type(NUM_LINK_TYPES_),
-      m_latency(p.link_latency), m_link_utilized(0),
+      m_latency(p.link_latency), src_object(nullptr), m_link_utilized(0),
+      m_crosses_partition(false), m_staged_flits(),
       m_virt_nets(p.virt_nets), linkBuffer(),
       link_consumer(nullptr), link_srcQueue(nullptr)
 {
@@ -98,8 +99,15 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_crosses_partition) {
+            // The consumer belongs to another partition. The link latency
+            // covers the time until the next exchange, so hold the flit
+            // here and let GarnetNetwork deliver it then.
+            m_staged_flits.insert(t_flit);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -109,6 +117,22 @@ NetworkLink::wakeup()
     }
 }
 
+/*
+ * Called by GarnetNetwork at a partition exchange, while all event queues
+ * are stopped at the barrier and the current event queue is the one the
+ * link consumer belongs to.
+ */
+void
+NetworkLink::deliverStagedFlits()
+{
+    while (!m_staged_flits.isEmpty()) {
+        flit *t_flit = m_staged_flits.getTopFlit();
+        assert(t_flit->get_time() >= curTick());
+        linkBuffer.insert(t_flit);
+        link_consumer->scheduleEventAbsolute(t_flit->get_time());
+    }
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -122,13 +146,17 @@ NetworkLink::resetStats()
 bool
 NetworkLink::functionalRead(Packet *pkt, WriteMask &mask)
 {
-    return linkBuffer.functionalRead(pkt, mask);
+    bool read = linkBuffer.functionalRead(pkt, mask);
+    if (m_staged_flits.functionalRead(pkt, mask))
+        read = true;
+    return read;
 }
 
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer.functionalWrite(pkt);
+    return linkBuffer.functionalWrite(pkt) +
+        m_staged_flits.functionalWrite(pkt);
 }
 
 } // namespace garnet
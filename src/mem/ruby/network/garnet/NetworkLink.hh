@@ -64,6 +64,8 @@ class NetworkLink : public ClockedObject, public Consumer
     void setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObject);
     virtual void setVcsPerVnet(uint32_t consumerVcs);
     void setType(link_type type) { m_type = type; }
+    ClockedObject *getSourceObject() const { return src_object; }
+    Consumer *getLinkConsumer() const { return link_consumer; }
     link_type getType() { return m_type; }
     void print(std::ostream& out) const {}
     int get_id() const { return m_id; }
@@ -86,6 +88,13 @@ class NetworkLink : public ClockedObject, public Consumer
     uint32_t functionalWrite(Packet *);
     void resetStats();
 
+    // Partitioned simulation: a link whose consumer runs on another
+    // event queue holds traversing flits until the next partition
+    // exchange, where deliverStagedFlits() hands them to the consumer.
+    void setCrossesPartition(bool crosses) { m_crosses_partition = crosses; }
+    bool crossesPartition() const { return m_crosses_partition; }
+    void deliverStagedFlits();
+
     std::vector<int> mVnets;
     uint32_t bitWidth;
 
@@ -100,6 +109,9 @@ class NetworkLink : public ClockedObject, public Consumer
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
 
+    bool m_crosses_partition;
+    flitBuffer m_staged_flits;
+
   protected:
     uint32_t m_virt_nets;
     flitBuffer linkBuffer;
@@ -159,7 +159,7 @@ Router::getInportDirection(int inport)
 }
 
 int
-Router::route_compute(RouteInfo route, int inport,
+Router::route_compute(const RouteInfo &route, int inport,
                       PortDirection inport_dirn, flit *t_flit)
 {
     return routingUnit.outportCompute(route, inport, inport_dirn, t_flit);
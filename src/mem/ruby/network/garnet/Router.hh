@@ -36,6 +36,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/random.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/BasicRouter.hh"
@@ -97,6 +98,11 @@ class Router : public BasicRouter, public Consumer
 
     GarnetNetwork* get_net_ptr()                    { return m_network_ptr; }
 
+    // Routers of a partitioned network draw routing decisions from a
+    // private generator instead of the global one.
+    void setPrivateRandom(uint32_t seed) { m_rng.reset(new Random(seed)); }
+    Random &getRandom() { return m_rng ? *m_rng : random_mt; }
+
     InputUnit*
     getInputUnit(unsigned port)
     {
@@ -118,7 +124,7 @@ class Router : public BasicRouter, public Consumer
     PortDirection getOutportDirection(int outport);
     PortDirection getInportDirection(int inport);
 
-    int route_compute(RouteInfo route, int inport,
+    int route_compute(const RouteInfo &route, int inport,
                       PortDirection direction, flit *t_flit);
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
@@ -150,6 +156,7 @@ class Router : public BasicRouter, public Consumer
     uint32_t m_virtual_networks, m_vc_per_vnet, m_num_vcs;
     uint32_t m_bit_width;
     GarnetNetwork *m_network_ptr;
+    std::unique_ptr<Random> m_rng;
 
     RoutingUnit routingUnit;
     SwitchAllocator switchAllocator;
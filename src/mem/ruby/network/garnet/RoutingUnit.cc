@@ -95,7 +95,7 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
@@ -138,8 +138,14 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
 
     // Randomly select any candidate output link
     int candidate = 0;
-    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet)) {
+        if (m_router->get_net_ptr()->isPartitioned()) {
+            candidate = m_router->getRandom().random<int>(0,
+                num_candidates - 1);
+        } else {
+            candidate = rand() % num_candidates;
+        }
+    }
 
     output_link = output_link_candidates.at(candidate);
     return output_link;
@@ -167,7 +173,7 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 // table is provided here.
 
 int
-RoutingUnit::outportCompute(RouteInfo route, int inport,
+RoutingUnit::outportCompute(const RouteInfo &route, int inport,
                             PortDirection inport_dirn, flit *t_flit)
 {
     int outport = -1;
@@ -215,7 +221,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
 int
-RoutingUnit::outportComputeXY(RouteInfo route,
+RoutingUnit::outportComputeXY(const RouteInfo &route,
                               int inport,
                               PortDirection inport_dirn,
                               flit *t_flit)
@@ -274,7 +280,7 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
-RoutingUnit::outportComputeCustom(RouteInfo route,
+RoutingUnit::outportComputeCustom(const RouteInfo &route,
                                   int inport,
                                   PortDirection inport_dirn,
                                   flit *t_flit)
@@ -308,7 +314,7 @@ RoutingUnit::outportComputeCustom(RouteInfo route,
 
 // minimal routing algorithm for dragonfly
 int
-RoutingUnit::outportComputeDragonflyMinimal(RouteInfo route,
+RoutingUnit::outportComputeDragonflyMinimal(const RouteInfo &route,
                                     int inport,
                                     PortDirection inport_dirn,
                                     flit *t_flit)
@@ -387,7 +393,8 @@ RoutingUnit::outportComputeUGAL(RouteInfo route,
     if (num_groups > 2 && group_cur != group_dst && my_id == route.src_router)
     {
         do {
-            group_mid = random_mt.random<unsigned>(0, num_groups - 1);
+            group_mid = m_router->getRandom().random<unsigned>(
+                0, num_groups - 1);
         } while (group_mid == group_cur || group_mid == group_dst);
       
         // estimate latency
@@ -590,7 +597,8 @@ RoutingUnit::outportComputeDragonflyVAL(RouteInfo route,
     if (num_groups > 2 && group_cur != group_dst && my_id == route.src_router)
     {
         do {
-            group_mid = random_mt.random<unsigned>(0, num_groups - 1);
+            group_mid = m_router->getRandom().random<unsigned>(
+                0, num_groups - 1);
         } while (group_mid == group_cur || group_mid == group_dst);
 
         route.intermediate_group = group_mid;
@@ -30,6 +30,9 @@
 
 #include "mem/ruby/network/garnet/flit.hh"
 
+#include <new>
+#include <utility>
+
 #include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
 
@@ -42,12 +45,82 @@ namespace ruby
 namespace garnet
 {
 
+namespace
+{
+
+// A free list of recycled flit storage for one object size. flit and
+// Credit each get their own list; anything else falls back to the heap.
+// The lists are per thread so that flits allocated on one event queue
+// and destroyed on another (partitioned simulation) need no locking.
+struct FlitFreeList
+{
+    struct Node
+    {
+        Node *next;
+    };
+
+    size_t size = 0;
+    Node *head = nullptr;
+
+    ~FlitFreeList()
+    {
+        while (head) {
+            Node *node = head;
+            head = node->next;
+            ::operator delete(node);
+        }
+    }
+};
+
+thread_local FlitFreeList flitFreeLists[2];
+
+FlitFreeList *
+flitFreeList(size_t size)
+{
+    for (auto &list : flitFreeLists) {
+        if (list.size == size)
+            return &list;
+        if (list.size == 0) {
+            list.size = size;
+            return &list;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+void *
+flit::operator new(size_t size)
+{
+    FlitFreeList *list = flitFreeList(size);
+    if (list && list->head) {
+        FlitFreeList::Node *node = list->head;
+        list->head = node->next;
+        return node;
+    }
+    return ::operator new(size);
+}
+
+void
+flit::operator delete(void *ptr, size_t size)
+{
+    FlitFreeList *list = flitFreeList(size);
+    if (!list) {
+        ::operator delete(ptr);
+        return;
+    }
+    auto *node = static_cast<FlitFreeList::Node *>(ptr);
+    node->next = list->head;
+    list->head = node;
+}
+
 // Constructor for the flit
-flit::flit(int packet_id, int id, int  vc, int vnet, RouteInfo route, int size,
-    MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
+flit::flit(int packet_id, int id, int  vc, int vnet, const RouteInfo &route,
+    int size, MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
 {
     m_size = size;
-    m_msg_ptr = msg_ptr;
+    m_msg_ptr = std::move(msg_ptr);
     m_enqueue_time = curTime;
     m_dequeue_time = curTime;
     m_time = curTime;
@@ -56,8 +129,8 @@ flit::flit(int packet_id, int id, int  vc, int vnet, RouteInfo route, int size,
     m_vnet = vnet;
     m_vc = vc;
     m_route = route;
-    m_stage.first = I_;
-    m_stage.second = curTime;
+    m_stage = I_;
+    m_stage_time = curTime;
     m_width = bWidth;
     msgSize = MsgSize;
 
@@ -51,11 +51,18 @@ class flit
 {
   public:
     flit() {}
-    flit(int packet_id, int id, int vc, int vnet, RouteInfo route, int size,
-         MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime);
+    flit(int packet_id, int id, int vc, int vnet, const RouteInfo &route,
+         int size, MsgPtr msg_ptr, int MsgSize, uint32_t bWidth,
+         Tick curTime);
 
     virtual ~flit(){};
 
+    // Flits and credits are created and destroyed for every hop of every
+    // packet. Their storage is recycled through per-thread free lists
+    // rather than going back to the heap each time.
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -65,16 +72,20 @@ class flit
     Tick get_time() { return m_time; }
     int get_vnet() { return m_vnet; }
     int get_vc() { return m_vc; }
-    RouteInfo get_route() { return m_route; }
+    const RouteInfo &get_route() const { return m_route; }
     MsgPtr& get_msg_ptr() { return m_msg_ptr; }
     flit_type get_type() { return m_type; }
-    std::pair<flit_stage, Tick> get_stage() { return m_stage; }
+    std::pair<flit_stage, Tick>
+    get_stage()
+    {
+        return std::make_pair(m_stage, m_stage_time);
+    }
     Tick get_src_delay() { return src_delay; }
 
     void set_outport(int port) { m_outport = port; }
     void set_time(Tick time) { m_time = time; }
     void set_vc(int vc) { m_vc = vc; }
-    void set_route(RouteInfo route) { m_route = route; }
+    void set_route(const RouteInfo &route) { m_route = route; }
     void set_src_delay(Tick delay) { src_delay = delay; }
     void set_dequeue_time(Tick time) { m_dequeue_time = time; }
     void set_enqueue_time(Tick time) { m_enqueue_time = time; }
@@ -85,15 +96,15 @@ class flit
     bool
     is_stage(flit_stage stage, Tick time)
     {
-        return (stage == m_stage.first &&
-                time >= m_stage.second);
+        return (stage == m_stage &&
+                time >= m_stage_time);
     }
 
     void
     advance_stage(flit_stage t_stage, Tick newTime)
     {
-        m_stage.first = t_stage;
-        m_stage.second = newTime;
+        m_stage = t_stage;
+        m_stage_time = newTime;
     }
 
     static bool
@@ -116,19 +127,21 @@ class flit
     uint32_t m_width;
     int msgSize;
   protected:
+    // Members are grouped by size to keep the object free of padding.
+    Tick m_enqueue_time, m_dequeue_time;
+    Tick m_time;
+    Tick src_delay;
+    Tick m_stage_time;
+    MsgPtr m_msg_ptr;
+    RouteInfo m_route;
     int m_packet_id;
     int m_id;
     int m_vnet;
     int m_vc;
-    RouteInfo m_route;
     int m_size;
-    Tick m_enqueue_time, m_dequeue_time;
-    Tick m_time;
-    flit_type m_type;
-    MsgPtr m_msg_ptr;
     int m_outport;
-    Tick src_delay;
-    std::pair<flit_stage, Tick> m_stage;
+    flit_type m_type;
+    flit_stage m_stage;
 };
 
 inline std::ostream&
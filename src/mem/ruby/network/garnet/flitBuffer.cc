@@ -40,26 +40,37 @@ namespace ruby
 namespace garnet
 {
 
+// Initial ring capacity for buffers without a known depth
+static const size_t defaultRingCapacity = 8;
+
 flitBuffer::flitBuffer()
+    : m_head(0), m_count(0)
 {
     max_size = INFINITE_;
+    grow(defaultRingCapacity);
 }
 
 flitBuffer::flitBuffer(int maximum_size)
+    : m_head(0), m_count(0)
 {
     max_size = maximum_size;
+    // unbounded buffers grow on demand, as with setMaxSize()
+    if (max_size > 0 && max_size < INFINITE_)
+        grow(max_size);
+    else
+        grow(defaultRingCapacity);
 }
 
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_count == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_count != 0) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -70,27 +81,46 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_count << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (getSize() >= max_size);
 }
 
 void
 flitBuffer::setMaxSize(int maximum)
 {
     max_size = maximum;
+    if (max_size > 0 && max_size < INFINITE_)
+        grow(max_size);
+}
+
+void
+flitBuffer::grow(size_t min_capacity)
+{
+    size_t capacity = std::max<size_t>(1, m_buffer.size());
+    while (capacity < min_capacity)
+        capacity *= 2;
+    if (capacity == m_buffer.size())
+        return;
+
+    // Unwrap the live flits to the front of the new ring
+    std::vector<flit *> ring(capacity, nullptr);
+    for (size_t i = 0; i < m_count; ++i)
+        ring[i] = at(i);
+    m_buffer.swap(ring);
+    m_head = 0;
 }
 
 bool
 flitBuffer::functionalRead(Packet *pkt, WriteMask &mask)
 {
     bool read = false;
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalRead(pkt, mask)) {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (at(i)->functionalRead(pkt, mask)) {
             read = true;
         }
     }
@@ -103,8 +133,8 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (at(i)->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -47,6 +48,11 @@ namespace ruby
 namespace garnet
 {
 
+// FIFO of flits kept in a power-of-two ring. The ring is sized from the
+// buffer depth when one is given, so VC buffers never allocate once the
+// network is built. Unbounded buffers start small and double on demand;
+// the storage is never released, so a buffer that has reached its
+// working size stays allocation free as well.
 class flitBuffer
 {
   public:
@@ -58,33 +64,49 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_count > 0);
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & (m_buffer.size() - 1);
+        m_count--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_count > 0);
+        return m_buffer[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_count == m_buffer.size())
+            grow(m_count + 1);
+        m_buffer[(m_head + m_count) & (m_buffer.size() - 1)] = flt;
+        m_count++;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    flit *
+    at(size_t i) const
+    {
+        return m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+    }
+
+    void grow(size_t min_capacity);
+
+    std::vector<flit *> m_buffer;
+    size_t m_head;
+    size_t m_count;
     int max_size;
 };
 
@@ -108,6 +108,18 @@ class AbstractController : public ClockedObject, public Consumer
     virtual void regStats();
 
     virtual void recordCacheTrace(int cntrl, CacheRecorder* tr) = 0;
+
+    //! Direct cache warmup from a CacheRecorder trace. A protocol takes
+    //! part by defining a warmupInstall() function in its state machines:
+    //! the owner installs the recorded line in its caches and returns
+    //! whether it did; only then the other controllers bring their
+    //! coherence state in line with it, e.g. a directory recording the
+    //! owner. Controllers without cache or directory structures have
+    //! nothing to install and always support it.
+    virtual bool supportsDirectWarmup() const = 0;
+    virtual bool installWarmupLine(Addr addr, RubyRequestType type,
+                                   MachineID owner,
+                                   const DataBlock &data) = 0;
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual DMASequencer* getDMASequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
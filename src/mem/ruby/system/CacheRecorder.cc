@@ -29,7 +29,12 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <cstring>
+
 #include "debug/RubyCacheTrace.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 
@@ -154,6 +159,111 @@ CacheRecorder::enqueueNextFetchRequest()
     }
 }
 
+/*
+ * Install the recorded lines straight into the controllers' caches and
+ * directories, oldest first so that the most recently used lines end up
+ * most recently used again. The owner of a line installs it first; only
+ * if it did, the controllers of other types update their coherence state.
+ * Lines the owner cannot take, e.g. when the set is full, are skipped.
+ */
+void
+CacheRecorder::installTrace(std::vector<AbstractController *> &cntrls,
+                            bool validate)
+{
+    uint64_t block_size = RubySystem::getBlockSizeBytes();
+    uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    uint64_t num_records = m_uncompressed_trace_size / record_size;
+    uint64_t installed = 0;
+    uint64_t skipped = 0;
+    uint64_t mismatches = 0;
+
+    for (uint64_t i = num_records; i-- > 0; ) {
+        TraceRecord *rec =
+            (TraceRecord *)(m_uncompressed_trace + i * record_size);
+        AbstractController *owner = cntrls[rec->m_cntrl_id];
+        MachineID owner_id = owner->getMachineID();
+
+        for (uint64_t offset = 0; offset < m_block_size_bytes;
+                offset += block_size) {
+            Addr addr = rec->m_data_address + offset;
+            DataBlock data;
+            data.setData(rec->m_data + offset, 0, block_size);
+
+            if (!owner->installWarmupLine(addr, rec->m_type, owner_id,
+                                          data)) {
+                DPRINTF(RubyCacheTrace, "Skipping %s\n", *rec);
+                skipped++;
+                continue;
+            }
+            for (auto cntrl : cntrls) {
+                if (cntrl->getType() != owner_id.getType())
+                    cntrl->installWarmupLine(addr, rec->m_type, owner_id,
+                                             data);
+            }
+            installed++;
+
+            if (validate &&
+                !validateLine(cntrls, owner, addr, rec->m_type,
+                              rec->m_data + offset)) {
+                mismatches++;
+            }
+        }
+    }
+
+    m_bytes_read = m_uncompressed_trace_size;
+    m_records_read = num_records;
+
+    fatal_if(mismatches > 0, "Cache warmup validation failed for %d of %d "
+             "installed lines\n", mismatches, installed);
+    inform("Installed %d recorded cache lines directly (%d skipped)%s\n",
+           installed, skipped, validate ? ", all validated" : "");
+}
+
+/*
+ * Check that the owner grants the recorded permission and returns the
+ * recorded data, and that no peer holds a line it owns for writing.
+ */
+bool
+CacheRecorder::validateLine(std::vector<AbstractController *> &cntrls,
+                            AbstractController *owner, Addr addr,
+                            RubyRequestType type, const uint8_t *data)
+{
+    uint64_t block_size = RubySystem::getBlockSizeBytes();
+    AccessPermission perm = owner->getAccessPermission(addr);
+    bool writable = perm == AccessPermission_Read_Write;
+    bool readable = writable || perm == AccessPermission_Read_Only;
+    if (!(type == RubyRequestType_ST ? writable : readable)) {
+        DPRINTF(RubyCacheTrace, "%s: %#x has permission %s\n",
+                owner->name(), addr, perm);
+        return false;
+    }
+
+    std::vector<uint8_t> buf(block_size);
+    RequestPtr req = std::make_shared<Request>(addr, block_size, 0,
+                                               Request::funcRequestorId);
+    Packet pkt(req, MemCmd::ReadReq);
+    pkt.dataStatic(buf.data());
+    owner->functionalRead(addr, &pkt);
+    if (memcmp(buf.data(), data, block_size) != 0) {
+        DPRINTF(RubyCacheTrace, "%s: %#x data differs from the trace\n",
+                owner->name(), addr);
+        return false;
+    }
+
+    if (writable) {
+        for (auto cntrl : cntrls) {
+            if (cntrl != owner && cntrl->getType() == owner->getType() &&
+                cntrl->getAccessPermission(addr) ==
+                    AccessPermission_Read_Write) {
+                DPRINTF(RubyCacheTrace, "%s: %#x is also writable in %s\n",
+                        owner->name(), addr, cntrl->name());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
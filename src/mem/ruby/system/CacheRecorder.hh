@@ -41,6 +41,7 @@
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
+#include "mem/ruby/protocol/AccessPermission.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 
 namespace gem5
@@ -49,6 +50,7 @@ namespace gem5
 namespace ruby
 {
 
+class AbstractController;
 class Sequencer;
 
 /*!
@@ -106,7 +108,21 @@ class CacheRecorder
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Function for warming up the caches without simulating. It installs
+     * all the recorded contents at once, straight into the caches and
+     * directories of the given controllers, which requires protocol
+     * support (see AbstractController::installWarmupLine). With validate
+     * set, each installed line is checked against the trace.
+     */
+    void installTrace(std::vector<AbstractController *> &cntrls,
+                      bool validate);
+
   private:
+    bool validateLine(std::vector<AbstractController *> &cntrls,
+                      AbstractController *owner, Addr addr,
+                      RubyRequestType type, const uint8_t *data);
+
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
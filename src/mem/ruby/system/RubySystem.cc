@@ -70,6 +70,7 @@ bool RubySystem::m_randomization;
 uint32_t RubySystem::m_block_size_bytes;
 uint32_t RubySystem::m_block_size_bits;
 uint32_t RubySystem::m_memory_size_bits;
+bool RubySystem::m_elide_data = false;
 bool RubySystem::m_warmup_enabled = false;
 // To look forward to allowing multiple RubySystem instances, track the number
 // of RubySystems that need to be warmed up on checkpoint restore.
@@ -78,7 +79,7 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
-      m_cache_recorder(NULL)
+      m_cache_warmup(p.cache_warmup), m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
@@ -87,6 +88,11 @@ RubySystem::RubySystem(const Params &p)
     m_block_size_bits = floorLog2(m_block_size_bytes);
     m_memory_size_bits = p.memory_size_bits;
 
+    // Data can only be dropped when the backing store holds it instead
+    fatal_if(p.elide_data && !m_access_backing_store,
+             "%s: elide_data requires access_backing_store\n", name());
+    m_elide_data = p.elide_data;
+
     // Resize to the size of different machine types
     m_abstract_controls.resize(MachineType_NUM);
 
@@ -417,6 +423,16 @@ RubySystem::init()
     registerRequestorIDs();
 }
 
+bool
+RubySystem::directWarmupSupported() const
+{
+    for (auto cntrl : m_abs_cntrl_vec) {
+        if (!cntrl->supportsDirectWarmup())
+            return false;
+    }
+    return true;
+}
+
 void
 RubySystem::startup()
 {
@@ -437,7 +453,29 @@ RubySystem::startup()
     // Ruby finishes restoring the state is less than the time when the
     // state was checkpointed.
 
-    if (m_warmup_enabled) {
+    bool direct_warmup = m_warmup_enabled &&
+        m_cache_warmup != RubyCacheWarmup::timing;
+    if (direct_warmup && !directWarmupSupported()) {
+        warn("%s: protocol does not support direct cache warmup, "
+             "replaying the cache trace in timing mode instead\n", name());
+        direct_warmup = false;
+    }
+
+    if (direct_warmup) {
+        // Install the trace straight into the caches and directories.
+        // Nothing is simulated, so neither the clock nor the event queue
+        // need to be touched.
+        DPRINTF(RubyCacheTrace, "Starting direct ruby cache warmup\n");
+        m_cache_recorder->installTrace(m_abs_cntrl_vec,
+            m_cache_warmup == RubyCacheWarmup::validate);
+
+        delete m_cache_recorder;
+        m_cache_recorder = NULL;
+        m_systems_to_warmup--;
+        if (m_systems_to_warmup == 0) {
+            m_warmup_enabled = false;
+        }
+    } else if (m_warmup_enabled) {
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -39,6 +39,7 @@
 
 #include "base/callback.hh"
 #include "base/output.hh"
+#include "enums/RubyCacheWarmup.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/profiler/Profiler.hh"
 #include "mem/ruby/slicc_interface/AbstractController.hh"
@@ -70,6 +71,7 @@ class RubySystem : public ClockedObject
     // config accessors
     static int getRandomization() { return m_randomization; }
     static uint32_t getBlockSizeBytes() { return m_block_size_bytes; }
+    static bool getElideData() { return m_elide_data; }
     static uint32_t getBlockSizeBits() { return m_block_size_bits; }
     static uint32_t getMemorySizeBits() { return m_memory_size_bits; }
     static bool getWarmupEnabled() { return m_warmup_enabled; }
@@ -133,17 +135,22 @@ class RubySystem : public ClockedObject
 
     void processRubyEvent();
   private:
+    // Whether every controller can install warmup lines directly
+    bool directWarmupSupported() const;
+
     // configuration parameters
     static bool m_randomization;
     static uint32_t m_block_size_bytes;
     static uint32_t m_block_size_bits;
     static uint32_t m_memory_size_bits;
+    static bool m_elide_data;
 
     static bool m_warmup_enabled;
     static unsigned m_systems_to_warmup;
     static bool m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const RubyCacheWarmup m_cache_warmup;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
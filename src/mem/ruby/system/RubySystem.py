@@ -30,6 +30,10 @@ from m5.objects.ClockedObject import ClockedObject
 from m5.objects.SimpleMemory import *
 
 
+class RubyCacheWarmup(ScopedEnum):
+    vals = ["timing", "direct", "validate"]
+
+
 class RubySystem(ClockedObject):
     type = "RubySystem"
     cxx_header = "mem/ruby/system/RubySystem.hh"
@@ -57,6 +61,22 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    elide_data = Param.Bool(
+        False,
+        "Do not keep data in the caches, messages and TBEs. All data "
+        "blocks share a single zero line and writes to them are dropped. "
+        "Requires access_backing_store.",
+    )
+
+    cache_warmup = Param.RubyCacheWarmup(
+        "timing",
+        "How to restore the cache contents from a checkpoint: replay the "
+        "recorded accesses in timing mode, install them directly into the "
+        "caches and directories, or install them directly and check every "
+        "line. The direct modes need protocol support and otherwise fall "
+        "back to timing.",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -0,0 +1,75 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import *
+
+
+# Policy choosing the next packet to issue from a controller queue,
+# overriding the built-in mem_sched_policy of the controller
+class MemSchedPolicy(SimObject):
+    type = "MemSchedPolicy"
+    abstract = True
+    cxx_header = "mem/sched/policy.hh"
+    cxx_class = "gem5::memory::sched::Policy"
+
+
+# First-ready first-come first-served: row hits that can issue
+# seamlessly first, then other row hits, then the oldest packet
+class FRFCFSSchedPolicy(MemSchedPolicy):
+    type = "FRFCFSSchedPolicy"
+    cxx_header = "mem/sched/policy_frfcfs.hh"
+    cxx_class = "gem5::memory::sched::FRFCFSPolicy"
+
+
+# Blacklisting memory scheduler (Subramanian et al., ICCD 2014):
+# requestors served too many times in a row are deprioritised until
+# the blacklist is next cleared
+class BLISSSchedPolicy(MemSchedPolicy):
+    type = "BLISSSchedPolicy"
+    cxx_header = "mem/sched/policy_bliss.hh"
+    cxx_class = "gem5::memory::sched::BLISSPolicy"
+
+    blacklist_threshold = Param.Unsigned(
+        4, "Consecutive bursts of a requestor before it is blacklisted"
+    )
+    clearing_interval = Param.Latency(
+        "10us", "Interval at which the blacklist is cleared"
+    )
+
+
+# Adaptive per-thread least-attained-service scheduler (Kim et al.,
+# HPCA 2010): requestors that got the least service in the past
+# quanta come first, unless a packet has waited too long
+class ATLASSchedPolicy(MemSchedPolicy):
+    type = "ATLASSchedPolicy"
+    cxx_header = "mem/sched/policy_atlas.hh"
+    cxx_class = "gem5::memory::sched::ATLASPolicy"
+
+    quantum = Param.Latency("10us", "Length of a ranking quantum")
+    history_weight = Param.Float(
+        0.875, "Weight of the past quanta in the attained service"
+    )
+    starvation_threshold = Param.Latency(
+        "5us", "Time after which a packet is served before any other"
+    )
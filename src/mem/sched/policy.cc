@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sched/policy.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "params/MemSchedPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace sched
+{
+
+void
+QueueSnapshot::clear()
+{
+    bank.clear();
+    row.clear();
+    arrival.clear();
+    source.clear();
+    priority.clear();
+    ready.clear();
+    rowHit.clear();
+    seamless.clear();
+}
+
+void
+QueueSnapshot::add(uint16_t _bank, uint32_t _row, Tick _arrival,
+                   RequestorID _source, uint8_t _priority)
+{
+    bank.push_back(_bank);
+    row.push_back(_row);
+    arrival.push_back(_arrival);
+    source.push_back(_source);
+    priority.push_back(_priority);
+    ready.push_back(0);
+    rowHit.push_back(0);
+    seamless.push_back(0);
+}
+
+Policy::Policy(const Params &p)
+  : SimObject(p)
+{}
+
+void
+Policy::prepareKeys(const QueueSnapshot &snapshot)
+{
+    panic_if(snapshot.size() > indexMask,
+             "%s: Queue of %d packets is too large to schedule\n",
+             name(), snapshot.size());
+    keys.resize(snapshot.size());
+}
+
+size_t
+Policy::lowestKey() const
+{
+    uint64_t lowest = notReady;
+    for (size_t i = 0; i < keys.size(); ++i)
+        lowest = std::min(lowest, keys[i]);
+
+    return lowest == notReady ? keys.size() : lowest & indexMask;
+}
+
+size_t
+Policy::numSources(const QueueSnapshot &snapshot)
+{
+    RequestorID largest = 0;
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        largest = std::max(largest, snapshot.source[i]);
+    return size_t(largest) + 1;
+}
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
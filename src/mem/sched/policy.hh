@@ -0,0 +1,143 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SCHED_POLICY_HH__
+#define __MEM_SCHED_POLICY_HH__
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/request.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct MemSchedPolicyParams;
+
+namespace memory
+{
+
+namespace sched
+{
+
+/**
+ * A snapshot of the packets in a controller queue, in queue order, as
+ * seen by a scheduling policy. The snapshot is a structure of arrays
+ * so that policies evaluate all packets in simple loops over
+ * contiguous data, which the compiler vectorises, rather than calling
+ * back into the controller for every packet.
+ *
+ * The controller fills in the packet fields and the memory interface
+ * the fields that depend on the state of the banks.
+ */
+struct QueueSnapshot
+{
+    /** Bank id, i.e., rank * banks per rank + bank */
+    std::vector<uint16_t> bank;
+    std::vector<uint32_t> row;
+    /** Tick the packet entered the controller */
+    std::vector<Tick> arrival;
+    std::vector<RequestorID> source;
+    /** QoS priority of the packet */
+    std::vector<uint8_t> priority;
+
+    /** One if the packet can issue now, i.e., its rank is available */
+    std::vector<uint8_t> ready;
+    /** One if the packet is to the open row of its bank */
+    std::vector<uint8_t> rowHit;
+    /** One if the column command can issue without additional delay */
+    std::vector<uint8_t> seamless;
+
+    size_t size() const { return bank.size(); }
+
+    void clear();
+
+    /** Add a packet, the interface fields start out as zero */
+    void add(uint16_t _bank, uint32_t _row, Tick _arrival,
+             RequestorID _source, uint8_t _priority);
+};
+
+/**
+ * Memory scheduling policy base class: policies derive from this
+ * class to choose which packet of a controller queue to issue next.
+ */
+class Policy : public SimObject
+{
+  public:
+    using Params = MemSchedPolicyParams;
+    Policy(const Params &p);
+
+    /**
+     * Choose the packet to issue next. The controller issues the
+     * packet chosen straight away, so policies may account for it as
+     * served.
+     *
+     * @param snapshot The packets of the queue
+     * @return Index of the packet, or snapshot.size() if none is ready
+     */
+    virtual size_t choose(const QueueSnapshot &snapshot) = 0;
+
+  protected:
+    /**
+     * Packets are ranked by a key, the lowest key being chosen. The
+     * position of a packet in the queue is in the low bits of its key,
+     * so keys are unique and the oldest packet wins on equal ranks.
+     */
+    static constexpr int indexBits = 24;
+    static constexpr uint64_t indexMask = (1ULL << indexBits) - 1;
+    static constexpr uint64_t notReady =
+        std::numeric_limits<uint64_t>::max();
+
+    /** The key of each packet, computed by the policy */
+    std::vector<uint64_t> keys;
+
+    /**
+     * Compose the key of a packet from its rank, forcing it to
+     * notReady if the packet cannot issue.
+     */
+    static uint64_t
+    key(uint64_t rank, size_t index, uint8_t ready)
+    {
+        return (rank << indexBits | index) | (uint64_t(ready) - 1);
+    }
+
+    /** Size the keys for a snapshot */
+    void prepareKeys(const QueueSnapshot &snapshot);
+
+    /** The packet with the lowest key, or the size if none is ready */
+    size_t lowestKey() const;
+
+    /** One more than the largest requestor id in a snapshot */
+    static size_t numSources(const QueueSnapshot &snapshot);
+};
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_SCHED_POLICY_HH__
@@ -0,0 +1,116 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sched/policy_atlas.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "base/logging.hh"
+#include "params/ATLASSchedPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace sched
+{
+
+ATLASPolicy::ATLASPolicy(const Params &p)
+  : Policy(p), quantum(p.quantum), historyWeight(p.history_weight),
+    starvationThreshold(p.starvation_threshold), quantumEnd(p.quantum)
+{
+    fatal_if(quantum == 0, "%s: The quantum must not be zero\n", name());
+    fatal_if(historyWeight < 0 || historyWeight >= 1,
+             "%s: The history weight must be in [0, 1)\n", name());
+}
+
+void
+ATLASPolicy::endQuantum()
+{
+    // quanta without any scheduling decision only age the history
+    const Tick elapsed = (curTick() - quantumEnd) / quantum;
+    const double aging = std::pow(historyWeight, double(elapsed));
+
+    for (size_t s = 0; s < history.size(); ++s) {
+        history[s] = (historyWeight * history[s] +
+                      (1 - historyWeight) * attained[s]) * aging;
+        attained[s] = 0;
+    }
+
+    std::vector<uint32_t> order(history.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](uint32_t a, uint32_t b)
+                     { return history[a] < history[b]; });
+    for (uint32_t r = 0; r < order.size(); ++r)
+        ranks[order[r]] = r;
+
+    quantumEnd += (elapsed + 1) * quantum;
+}
+
+size_t
+ATLASPolicy::choose(const QueueSnapshot &snapshot)
+{
+    if (curTick() >= quantumEnd)
+        endQuantum();
+
+    // requestors seen for the first time have not attained any
+    // service, and rank with the least served ones
+    if (history.size() < numSources(snapshot)) {
+        attained.resize(numSources(snapshot), 0);
+        history.resize(numSources(snapshot), 0);
+        ranks.resize(numSources(snapshot), 0);
+    }
+
+    prepareKeys(snapshot);
+    packetRanks.resize(snapshot.size());
+
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        packetRanks[i] = ranks[snapshot.source[i]];
+
+    const Tick now = curTick();
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const uint64_t not_starving =
+            snapshot.arrival[i] + starvationThreshold > now;
+        const uint64_t rank = not_starving << 17 |
+            uint64_t(packetRanks[i]) << 1 | (1 - snapshot.rowHit[i]);
+        keys[i] = key(rank, i, snapshot.ready[i]);
+    }
+
+    const size_t chosen = lowestKey();
+    if (chosen != snapshot.size())
+        attained[snapshot.source[chosen]]++;
+
+    return chosen;
+}
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
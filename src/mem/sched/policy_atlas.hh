@@ -0,0 +1,90 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SCHED_POLICY_ATLAS_HH__
+#define __MEM_SCHED_POLICY_ATLAS_HH__
+
+#include <vector>
+
+#include "mem/sched/policy.hh"
+
+namespace gem5
+{
+
+struct ATLASSchedPolicyParams;
+
+namespace memory
+{
+
+namespace sched
+{
+
+/**
+ * Adaptive per-thread least-attained-service scheduling, see Kim et
+ * al., "ATLAS: A scalable and high-performance scheduling algorithm
+ * for multiple memory controllers", HPCA 2010.
+ *
+ * Time is divided into quanta. At the end of a quantum, the service
+ * attained by each requestor, in bursts, is folded into a weighted
+ * history, and requestors are ranked by it, least served first.
+ * Packets that waited longer than the starvation threshold come
+ * first, then packets by rank, then row hits, then older packets.
+ */
+class ATLASPolicy : public Policy
+{
+  public:
+    using Params = ATLASSchedPolicyParams;
+    ATLASPolicy(const Params &p);
+
+    size_t choose(const QueueSnapshot &snapshot) override;
+
+  protected:
+    const Tick quantum;
+    const double historyWeight;
+    const Tick starvationThreshold;
+
+    /** Per requestor id, the service attained in this quantum */
+    std::vector<uint64_t> attained;
+
+    /** Per requestor id, the service attained in the past quanta */
+    std::vector<double> history;
+
+    /** Per requestor id, the rank, 0 being served first */
+    std::vector<uint32_t> ranks;
+
+    Tick quantumEnd;
+
+    /** Fold the attained service in the history and rerank */
+    void endQuantum();
+
+    /** The rank of the requestor of each packet */
+    std::vector<uint32_t> packetRanks;
+};
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_SCHED_POLICY_ATLAS_HH__
@@ -0,0 +1,86 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sched/policy_bliss.hh"
+
+#include <algorithm>
+
+#include "params/BLISSSchedPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace sched
+{
+
+BLISSPolicy::BLISSPolicy(const Params &p)
+  : Policy(p), blacklistThreshold(p.blacklist_threshold),
+    clearingInterval(p.clearing_interval),
+    lastSource(Request::invldRequestorId), streak(0),
+    nextClear(p.clearing_interval)
+{}
+
+size_t
+BLISSPolicy::choose(const QueueSnapshot &snapshot)
+{
+    if (curTick() >= nextClear) {
+        std::fill(blacklisted.begin(), blacklisted.end(), 0);
+        nextClear = curTick() + clearingInterval;
+    }
+
+    if (blacklisted.size() < numSources(snapshot))
+        blacklisted.resize(numSources(snapshot), 0);
+
+    prepareKeys(snapshot);
+    listed.resize(snapshot.size());
+
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        listed[i] = blacklisted[snapshot.source[i]];
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const uint64_t rank = uint64_t(listed[i]) << 1 |
+            (1 - snapshot.rowHit[i]);
+        keys[i] = key(rank, i, snapshot.ready[i]);
+    }
+
+    const size_t chosen = lowestKey();
+    if (chosen == snapshot.size())
+        return chosen;
+
+    const RequestorID source = snapshot.source[chosen];
+    streak = source == lastSource ? streak + 1 : 1;
+    lastSource = source;
+    if (streak > blacklistThreshold)
+        blacklisted[source] = 1;
+
+    return chosen;
+}
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,83 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SCHED_POLICY_BLISS_HH__
+#define __MEM_SCHED_POLICY_BLISS_HH__
+
+#include <vector>
+
+#include "mem/sched/policy.hh"
+
+namespace gem5
+{
+
+struct BLISSSchedPolicyParams;
+
+namespace memory
+{
+
+namespace sched
+{
+
+/**
+ * Blacklisting memory scheduler, see Subramanian et al., "The
+ * Blacklisting Memory Scheduler: Achieving high performance and
+ * fairness at low cost", ICCD 2014.
+ *
+ * A requestor served more than a threshold number of times in a row
+ * is blacklisted. Packets of requestors that are not blacklisted come
+ * first, then row hits, then older packets. The blacklist is cleared
+ * periodically.
+ */
+class BLISSPolicy : public Policy
+{
+  public:
+    using Params = BLISSSchedPolicyParams;
+    BLISSPolicy(const Params &p);
+
+    size_t choose(const QueueSnapshot &snapshot) override;
+
+  protected:
+    const unsigned blacklistThreshold;
+    const Tick clearingInterval;
+
+    /** Blacklisted requestors, indexed by requestor id */
+    std::vector<uint8_t> blacklisted;
+
+    /** The requestor last served, and how many times in a row */
+    RequestorID lastSource;
+    unsigned streak;
+
+    Tick nextClear;
+
+    /** Whether the requestor of each packet is blacklisted */
+    std::vector<uint8_t> listed;
+};
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_SCHED_POLICY_BLISS_HH__
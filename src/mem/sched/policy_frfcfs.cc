@@ -0,0 +1,60 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sched/policy_frfcfs.hh"
+
+#include "params/FRFCFSSchedPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace sched
+{
+
+FRFCFSPolicy::FRFCFSPolicy(const Params &p)
+  : Policy(p)
+{}
+
+size_t
+FRFCFSPolicy::choose(const QueueSnapshot &snapshot)
+{
+    prepareKeys(snapshot);
+
+    // rank 0 for seamless hits, 1 for other hits and 2 for misses
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const uint64_t rank = 2 - snapshot.rowHit[i] -
+            (snapshot.rowHit[i] & snapshot.seamless[i]);
+        keys[i] = key(rank, i, snapshot.ready[i]);
+    }
+
+    return lowestKey();
+}
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,62 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SCHED_POLICY_FRFCFS_HH__
+#define __MEM_SCHED_POLICY_FRFCFS_HH__
+
+#include "mem/sched/policy.hh"
+
+namespace gem5
+{
+
+struct FRFCFSSchedPolicyParams;
+
+namespace memory
+{
+
+namespace sched
+{
+
+/**
+ * First-ready first-come first-served: the oldest row hit that can
+ * issue seamlessly, else the oldest row hit, else the oldest packet.
+ * Unlike the built-in FR-FCFS of the DRAM interface, this policy does
+ * not look for misses whose activate can be hidden, and serves as a
+ * reference for other policies.
+ */
+class FRFCFSPolicy : public Policy
+{
+  public:
+    using Params = FRFCFSSchedPolicyParams;
+    FRFCFSPolicy(const Params &p);
+
+    size_t choose(const QueueSnapshot &snapshot) override;
+};
+
+} // namespace sched
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_SCHED_POLICY_FRFCFS_HH__
@@ -40,6 +40,8 @@
 
 #include "mem/simple_mem.hh"
 
+#include <algorithm>
+
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/Drain.hh"
@@ -53,7 +55,8 @@ namespace memory
 SimpleMemory::SimpleMemory(const SimpleMemoryParams &p) :
     AbstractMemory(p),
     port(name() + ".port", *this), latency(p.latency),
-    latency_var(p.latency_var), bandwidth(p.bandwidth), isBusy(false),
+    latency_var(p.latency_var), backdoorTiming(p.backdoor_timing),
+    bandwidth(p.bandwidth), isBusy(false),
     retryReq(false), retryResp(false),
     releaseEvent([this]{ release(); }, name()),
     dequeueEvent([this]{ dequeue(); }, name())
@@ -98,11 +101,12 @@ SimpleMemory::recvFunctional(PacketPtr pkt)
     functionalAccess(pkt);
 
     bool done = false;
-    auto p = packetQueue.begin();
-    // potentially update the packets in our packet queue as well
-    while (!done && p != packetQueue.end()) {
-        done = pkt->trySatisfyFunctional(p->pkt);
-        ++p;
+    // potentially update the packets in our packet queue as well,
+    // packets without data only see the backing store, which the
+    // functional access already used
+    for (size_t i = 0; !done && i < packetQueue.size(); ++i) {
+        if (packetQueue[i].pkt->hasData())
+            done = pkt->trySatisfyFunctional(packetQueue[i].pkt);
     }
 
     pkt->popLabel();
@@ -125,6 +129,10 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
              "Should only see read and writes at memory controller, "
              "saw %s to %#llx\n", pkt->cmdString(), pkt->getAddr());
 
+    panic_if(!pkt->hasData() && !backdoorTiming,
+             "Packet without data to %#llx, this needs backdoor_timing\n",
+             pkt->getAddr());
+
     // we should not get a new request after committing to retry the
     // current one, but unfortunately the CPU violates this rule, so
     // simply ignore it for now
@@ -173,20 +181,7 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
 
         Tick when_to_send = curTick() + receive_delay + getLatency();
 
-        // typically this should be added at the end, so start the
-        // insertion sort with the last element, also make sure not to
-        // re-order in front of some existing packet with the same
-        // address, the latter is important as this memory effectively
-        // hands out exclusive copies (shared is not asserted)
-        auto i = packetQueue.end();
-        --i;
-        while (i != packetQueue.begin() && when_to_send < i->tick &&
-               !i->pkt->matchAddr(pkt))
-            --i;
-
-        // emplace inserts the element before the position pointed to by
-        // the iterator, so advance it one step
-        packetQueue.emplace(++i, pkt, when_to_send);
+        packetQueue.insert(pkt, when_to_send);
 
         if (!retryResp && !dequeueEvent.scheduled())
             schedule(dequeueEvent, packetQueue.back().tick);
@@ -214,6 +209,12 @@ SimpleMemory::dequeue()
     assert(!packetQueue.empty());
     DeferredPacket deferred_pkt = packetQueue.front();
 
+    // a read without data gets the data from the backing store as it
+    // is at the time of the response, without copying
+    PacketPtr pkt = deferred_pkt.pkt;
+    if (!pkt->hasData() && pkt->isRead() && pmemAddr)
+        pkt->dataStatic(toHostAddr(pkt->getAddr()));
+
     retryResp = !port.sendTimingResp(deferred_pkt.pkt);
 
     if (!retryResp) {
@@ -233,6 +234,44 @@ SimpleMemory::dequeue()
     }
 }
 
+void
+SimpleMemory::DeferredPacketQueue::grow()
+{
+    std::vector<DeferredPacket> new_ring(std::max<size_t>(ring.size() * 2,
+                                                          16));
+    for (size_t i = 0; i < numPkts; ++i)
+        new_ring[i] = elem(i);
+    ring.swap(new_ring);
+    head = 0;
+}
+
+void
+SimpleMemory::DeferredPacketQueue::insert(PacketPtr pkt, Tick tick)
+{
+    if (numPkts == ring.size())
+        grow();
+
+    // typically this should be added at the end, so start the
+    // insertion sort with the last element, moving the packets it
+    // passes one step back
+    size_t idx = numPkts;
+    while (idx > 1 && tick < elem(idx - 1).tick &&
+           !elem(idx - 1).pkt->matchAddr(pkt)) {
+        elem(idx) = elem(idx - 1);
+        --idx;
+    }
+    elem(idx) = DeferredPacket(pkt, tick);
+    ++numPkts;
+}
+
+void
+SimpleMemory::DeferredPacketQueue::pop_front()
+{
+    assert(numPkts);
+    head = (head + 1) & (ring.size() - 1);
+    --numPkts;
+}
+
 Tick
 SimpleMemory::getLatency() const
 {
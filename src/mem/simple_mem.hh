@@ -46,7 +46,7 @@
 #ifndef __MEM_SIMPLE_MEMORY_HH__
 #define __MEM_SIMPLE_MEMORY_HH__
 
-#include <list>
+#include <vector>
 
 #include "mem/abstract_mem.hh"
 #include "mem/port.hh"
@@ -78,13 +78,61 @@ class SimpleMemory : public AbstractMemory
 
       public:
 
-        const Tick tick;
-        const PacketPtr pkt;
+        Tick tick;
+        PacketPtr pkt;
 
-        DeferredPacket(PacketPtr _pkt, Tick _tick) : tick(_tick), pkt(_pkt)
+        DeferredPacket(PacketPtr _pkt = nullptr, Tick _tick = 0)
+            : tick(_tick), pkt(_pkt)
         { }
     };
 
+    /**
+     * Ring of deferred packets ordered by their transmission time. It
+     * grows as needed, and as packets are typically added at the back
+     * neither adding nor removing them allocates.
+     */
+    class DeferredPacketQueue
+    {
+      private:
+
+        std::vector<DeferredPacket> ring;
+        size_t head = 0;
+        size_t numPkts = 0;
+
+        DeferredPacket &
+        elem(size_t idx)
+        {
+            return ring[(head + idx) & (ring.size() - 1)];
+        }
+
+        /** Double the capacity of the ring */
+        void grow();
+
+      public:
+
+        bool empty() const { return numPkts == 0; }
+        size_t size() const { return numPkts; }
+
+        const DeferredPacket &
+        operator[](size_t idx) const
+        {
+            return ring[(head + idx) & (ring.size() - 1)];
+        }
+
+        const DeferredPacket &front() const { return (*this)[0]; }
+        const DeferredPacket &back() const { return (*this)[numPkts - 1]; }
+
+        /**
+         * Add a packet in transmission time order, though never in
+         * front of the packet at the front nor of one with the same
+         * address. The latter is important as this memory effectively
+         * hands out exclusive copies (shared is not asserted).
+         */
+        void insert(PacketPtr pkt, Tick tick);
+
+        void pop_front();
+    };
+
     class MemoryPort : public ResponsePort
     {
       private:
@@ -123,7 +171,13 @@ class SimpleMemory : public AbstractMemory
      * actual memory access. Note that this is where the packet spends
      * the memory latency.
      */
-    std::list<DeferredPacket> packetQueue;
+    DeferredPacketQueue packetQueue;
+
+    /**
+     * Accept timing packets without data, and point read responses
+     * at the backing store when they are sent instead of copying.
+     */
+    const bool backdoorTiming;
 
     /**
      * Bandwidth in ticks per byte. The regulation affects the
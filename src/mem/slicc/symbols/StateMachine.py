@@ -355,6 +355,9 @@ class $c_ident : public AbstractController
     void collateStats();
 
     void recordCacheTrace(int cntrl, CacheRecorder* tr);
+    bool supportsDirectWarmup() const;
+    bool installWarmupLine(Addr addr, RubyRequestType type, MachineID owner,
+                           const DataBlock &data);
     Sequencer* getCPUSequencer() const;
     DMASequencer* getDMASequencer() const;
     GPUCoalescer* getGPUCoalescer() const;
@@ -1181,6 +1184,43 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
         code(
             """
 }
+"""
+        )
+
+        #
+        # Direct cache warmup goes through the machine's warmupInstall
+        # function. Machines without caches or directories take no part.
+        #
+        has_warmup = any(
+            func.c_name == "warmupInstall" for func in self.functions
+        )
+        has_state = any(
+            param.type_ast.type.ident in ("CacheMemory", "DirectoryMemory")
+            for param in self.config_parameters
+        )
+        supports_warmup = "true" if has_warmup or not has_state else "false"
+        code(
+            """
+
+bool
+$c_ident::supportsDirectWarmup() const
+{
+    return $supports_warmup;
+}
+
+bool
+$c_ident::installWarmupLine(Addr addr, RubyRequestType type,
+                            MachineID owner, const DataBlock &data)
+{
+"""
+        )
+        if has_warmup:
+            code("    return warmupInstall(addr, type, owner, data);")
+        else:
+            code("    return false;")
+        code(
+            """
+}
 
 // Actions
 """
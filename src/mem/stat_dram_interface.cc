@@ -0,0 +1,221 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/stat_dram_interface.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/DRAM.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+StatDRAMInterface::StatDRAMInterface(const StatDRAMInterfaceParams &_p)
+    : MemInterface(_p),
+      detailed(*_p.detailed),
+      tRCD(_p.tRCD), tCL(_p.tCL), tRP(_p.tRP),
+      calibrationMinBursts(_p.calibration_min_bursts),
+      bandwidthWindow(_p.bandwidth_window),
+      maxUtilization(_p.max_utilization),
+      hitProb(_p.row_hit_prob),
+      noConflictProb(1 - _p.row_conflict_prob),
+      queueScale(tBURST / 2.0),
+      stats(*this)
+{
+    fatal_if(_p.row_hit_prob < 0 || _p.row_conflict_prob < 0 ||
+             _p.row_hit_prob + _p.row_conflict_prob > 1,
+             "%s: Row hit and conflict probabilities must add up to at "
+             "most 1\n", name());
+    fatal_if(maxUtilization <= 0 || maxUtilization >= 1,
+             "%s: Utilisation cap must be in (0, 1)\n", name());
+}
+
+void
+StatDRAMInterface::calibrate()
+{
+    const DRAMInterface::AccessProfile profile = detailed.takeProfile();
+    const uint64_t bursts = profile.rowHits + profile.rowMisses +
+        profile.rowConflicts;
+
+    // measure the bandwidth the model sees from scratch
+    windowStart = curTick();
+    windowBytes = 0;
+
+    if (bursts < calibrationMinBursts || curTick() == profile.since) {
+        DPRINTF(DRAM, "Keeping calibration, %d bursts in the interval\n",
+                bursts);
+        return;
+    }
+
+    hitProb = double(profile.rowHits) / bursts;
+    noConflictProb = double(profile.rowHits + profile.rowMisses) / bursts;
+
+    // the detailed queueing delay includes opening the row, leave that
+    // to the row buffer outcomes and fit what is left to the
+    // utilisation of the interval
+    const double rho = std::min(double(profile.bytes) * tBURST /
+        (double(burstSize) * (curTick() - profile.since)), maxUtilization);
+    if (profile.readBursts && rho > 0) {
+        const double row_overhead = (noConflictProb - hitProb) * tRCD +
+            (1 - noConflictProb) * (tRP + tRCD);
+        const double queue_lat = std::max(
+            double(profile.readQueueLat) / profile.readBursts - row_overhead,
+            0.0);
+        queueScale = queue_lat * (1 - rho) / rho;
+    }
+    utilization = rho;
+
+    stats.calibrations++;
+
+    DPRINTF(DRAM, "Calibrated from %d bursts: hit %f, miss %f, conflict %f,"
+            " utilisation %f, queue scale %f\n", bursts, hitProb,
+            noConflictProb - hitProb, 1 - noConflictProb, rho, queueScale);
+}
+
+void
+StatDRAMInterface::trackBandwidth(unsigned bytes)
+{
+    if (curTick() >= windowStart + bandwidthWindow) {
+        // if nothing arrived for several windows, so is the utilisation
+        // of the last one
+        const Tick elapsed = curTick() - windowStart;
+        utilization = std::min(double(windowBytes) * tBURST /
+            (double(burstSize) * elapsed), maxUtilization);
+        windowStart = curTick();
+        windowBytes = 0;
+    }
+    windowBytes += bytes;
+}
+
+Tick
+StatDRAMInterface::serve(PacketPtr pkt)
+{
+    const Addr offset = pkt->getAddr() & (burstSize - 1);
+    const unsigned bursts = divCeil(offset + pkt->getSize(), burstSize);
+
+    trackBandwidth(bursts * burstSize);
+
+    if (!pkt->isRead()) {
+        stats.writeBursts += bursts;
+        return 0;
+    }
+
+    const Tick queue_lat = queueScale * utilization / (1 - utilization);
+
+    // the first burst opens the row if needed, and the others follow
+    // back to back
+    Tick row_lat = 0;
+    const double outcome = random_mt.random<double>();
+    if (outcome < hitProb) {
+        stats.rowHits++;
+    } else if (outcome < noConflictProb) {
+        stats.rowMisses++;
+        row_lat = tRCD;
+    } else {
+        stats.rowConflicts++;
+        row_lat = tRP + tRCD;
+    }
+
+    const Tick latency = queue_lat + row_lat + tCL + bursts * tBURST;
+
+    stats.readBursts += bursts;
+    stats.totQLat += queue_lat;
+    stats.totMemAccLat += latency;
+
+    return latency;
+}
+
+Tick
+StatDRAMInterface::accessLatency() const
+{
+    return tCL + tBURST + (noConflictProb - hitProb) * tRCD +
+        (1 - noConflictProb) * (tRP + tRCD);
+}
+
+std::pair<MemPacketQueue::iterator, Tick>
+StatDRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue,
+                                    Tick min_col_at) const
+{
+    panic("%s: Requests are not queued for a statistical model\n", name());
+}
+
+void
+StatDRAMInterface::fillSchedSnapshot(const MemPacketQueue& queue,
+                                     Tick min_col_at,
+                                     sched::QueueSnapshot& snapshot) const
+{
+    panic("%s: Requests are not queued for a statistical model\n", name());
+}
+
+std::pair<Tick, Tick>
+StatDRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
+                                 const std::vector<MemPacketQueue>& queue)
+{
+    panic("%s: Requests are not queued for a statistical model\n", name());
+}
+
+StatDRAMInterface::StatDRAMStats::StatDRAMStats(StatDRAMInterface &dram)
+    : statistics::Group(&dram),
+
+    ADD_STAT(readBursts, statistics::units::Count::get(),
+             "Number of read bursts served by the model"),
+    ADD_STAT(writeBursts, statistics::units::Count::get(),
+             "Number of write bursts served by the model"),
+
+    ADD_STAT(rowHits, statistics::units::Count::get(),
+             "Number of reads drawn as row hits"),
+    ADD_STAT(rowMisses, statistics::units::Count::get(),
+             "Number of reads drawn as accesses to a closed bank"),
+    ADD_STAT(rowConflicts, statistics::units::Count::get(),
+             "Number of reads drawn as row conflicts"),
+
+    ADD_STAT(totQLat, statistics::units::Tick::get(),
+             "Total modelled queueing delay of the reads"),
+    ADD_STAT(totMemAccLat, statistics::units::Tick::get(),
+             "Total modelled latency of the reads"),
+    ADD_STAT(avgQLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average modelled queueing delay per read",
+             totQLat / (rowHits + rowMisses + rowConflicts)),
+    ADD_STAT(avgMemAccLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average modelled latency per read",
+             totMemAccLat / (rowHits + rowMisses + rowConflicts)),
+
+    ADD_STAT(calibrations, statistics::units::Count::get(),
+             "Number of times the model was calibrated")
+{
+    avgQLat.precision(2);
+    avgMemAccLat.precision(2);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,178 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * StatDRAMInterface declaration
+ */
+
+#ifndef __STAT_DRAM_INTERFACE_HH__
+#define __STAT_DRAM_INTERFACE_HH__
+
+#include "base/statistics.hh"
+#include "mem/dram_interface.hh"
+#include "mem/mem_interface.hh"
+#include "params/StatDRAMInterface.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A statistical stand-in for a DRAMInterface, e.g., for warming up
+ * over long phases. The controller does not queue the bursts of a
+ * request served by the model, but responds after a latency drawn
+ * from row hit, miss and conflict probabilities and a queueing term
+ * depending on the bandwidth the model sees, all calibrated from the
+ * detailed interface. There are no banks, ranks or refresh events to
+ * simulate, and the data is accessed through the detailed interface.
+ */
+class StatDRAMInterface : public MemInterface
+{
+  private:
+    /** The interface the model stands in for */
+    DRAMInterface &detailed;
+
+    const Tick tRCD;
+    const Tick tCL;
+    const Tick tRP;
+
+    const unsigned calibrationMinBursts;
+    const Tick bandwidthWindow;
+    const double maxUtilization;
+
+    /** Probabilities of a row hit, and of a hit or a closed bank */
+    double hitProb;
+    double noConflictProb;
+
+    /**
+     * The queueing delay at a utilisation u is queueScale * u / (1 - u),
+     * as for a queue with a deterministic service time
+     */
+    double queueScale;
+
+    /** Bandwidth measurement for the queueing term */
+    Tick windowStart = 0;
+    uint64_t windowBytes = 0;
+    double utilization = 0;
+
+    /**
+     * Account for the bytes of a request in the current bandwidth
+     * window, closing it if it is over
+     */
+    void trackBandwidth(unsigned bytes);
+
+    struct StatDRAMStats : public statistics::Group
+    {
+        StatDRAMStats(StatDRAMInterface &dram);
+
+        /** Bursts served by the model */
+        statistics::Scalar readBursts;
+        statistics::Scalar writeBursts;
+
+        /** Row buffer outcomes drawn for the reads */
+        statistics::Scalar rowHits;
+        statistics::Scalar rowMisses;
+        statistics::Scalar rowConflicts;
+
+        statistics::Scalar totQLat;
+        statistics::Scalar totMemAccLat;
+        statistics::Formula avgQLat;
+        statistics::Formula avgMemAccLat;
+
+        statistics::Scalar calibrations;
+    } stats;
+
+  public:
+    /**
+     * Calibrate the model from the detailed interface, using what it
+     * saw since it was switched to. Intervals that are too short keep
+     * the previous calibration.
+     */
+    void calibrate();
+
+    /**
+     * Start a new detailed interval to calibrate from, when the
+     * controller switches back to the detailed interface
+     */
+    void startInterval() { detailed.takeProfile(); }
+
+    /**
+     * Serve a request, drawing its latency from the model
+     *
+     * @param pkt The request
+     * @return The latency of the memory, excluding the controller
+     *         pipeline, until the data of a read is returned
+     */
+    Tick serve(PacketPtr pkt);
+
+    /**
+     * The model serves requests as they arrive, and never sees bursts
+     * through the queues of the controller
+     */
+    void setupRank(const uint8_t rank, const bool is_read) override {}
+    bool allRanksDrained() const override { return true; }
+
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
+
+    void fillSchedSnapshot(const MemPacketQueue& queue, Tick min_col_at,
+                           sched::QueueSnapshot& snapshot) const override;
+
+    /*
+     * Function to calulate the mean unloaded latency of the model
+     */
+    Tick accessLatency() const override;
+
+    Tick commandOffset() const override { return 0; }
+    bool burstReady(MemPacket* pkt) const override { return true; }
+    void addRankToRankDelay(Tick cmd_at) override {}
+
+    bool
+    isBusy(bool read_queue_empty, bool all_writes_nvm) override
+    {
+        return false;
+    }
+
+    std::pair<Tick, Tick>
+    doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
+                  const std::vector<MemPacketQueue>& queue) override;
+
+    void drainRanks() override {}
+    void suspend() override {}
+
+    bool readsWaitingToIssue() const override { return false; }
+    void chooseRead(MemPacketQueue& queue) override {}
+    bool writeRespQueueFull() const override { return false; }
+
+    StatDRAMInterface(const StatDRAMInterfaceParams &_p);
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__STAT_DRAM_INTERFACE_HH__
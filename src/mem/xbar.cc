@@ -45,6 +45,8 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -82,6 +84,9 @@ BaseXBar::~BaseXBar()
 
     for (auto port: cpuSidePorts)
         delete port;
+
+    for (auto state: freeRouteStates)
+        delete state;
 }
 
 Port &
@@ -145,12 +150,24 @@ BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
     statistics::Group(&_xbar, _name.c_str()),
     port(_port), xbar(_xbar), _name(xbar.name() + "." + _name), state(IDLE),
     waitingForPeer(NULL), releaseEvent([this]{ releaseLayer(); }, name()),
+    releaseDeferred(false), busyUntil(0),
     ADD_STAT(occupancy, statistics::units::Tick::get(), "Layer occupancy (ticks)"),
-    ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization")
+    ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization"),
+    ADD_STAT(deferredReleases, statistics::units::Count::get(),
+             "Number of occupancies released without an event as no port "
+             "was waiting for the layer"),
+    ADD_STAT(scheduledReleases, statistics::units::Count::get(),
+             "Number of occupancies released by an event")
 {
     occupancy
         .flags(statistics::nozero);
 
+    deferredReleases
+        .flags(statistics::nozero);
+
+    scheduledReleases
+        .flags(statistics::nozero);
+
     utilization
         .precision(1)
         .flags(statistics::nozero);
@@ -169,7 +186,20 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
 
     // until should never be 0 as express snoops never occupy the layer
     assert(until != 0);
-    xbar.schedule(releaseEvent, until);
+    assert(!releaseDeferred);
+
+    // if no one is waiting for the layer, there is nothing to do when
+    // it is released, so rather than scheduling the release we simply
+    // remember when the layer is free again
+    if (waitingForLayer.empty() && waitingForPeer == NULL &&
+        drainState() != DrainState::Draining) {
+        releaseDeferred = true;
+        busyUntil = until;
+        deferredReleases++;
+    } else {
+        xbar.schedule(releaseEvent, until);
+        scheduledReleases++;
+    }
 
     // account for the occupied ticks
     occupancy += until - curTick();
@@ -188,6 +218,9 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
     // this state again in zero time if the peer does not immediately
     // call the layer when receiving the retry
 
+    if (releaseDeferred)
+        settleRelease();
+
     // first we see if the layer is busy, next we check if the
     // destination port is already engaged in a transaction waiting
     // for a retry from the peer
@@ -243,6 +276,25 @@ BaseXBar::Layer<SrcType, DstType>::failedTiming(SrcType* src_port,
     occupyLayer(busy_time);
 }
 
+template <typename SrcType, typename DstType>
+void
+BaseXBar::Layer<SrcType, DstType>::settleRelease()
+{
+    assert(releaseDeferred && state == BUSY);
+    releaseDeferred = false;
+
+    if (curTick() >= busyUntil) {
+        // the occupancy is over and no one waited for it, so there
+        // is nothing else to do
+        DPRINTF(BaseXBar, "The crossbar layer was released at tick %d\n",
+                busyUntil);
+        state = IDLE;
+    } else {
+        // someone is about to wait for the layer
+        xbar.schedule(releaseEvent, busyUntil);
+    }
+}
+
 template <typename SrcType, typename DstType>
 void
 BaseXBar::Layer<SrcType, DstType>::releaseLayer()
@@ -310,6 +362,9 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
     // something to this port
     assert(waitingForPeer != NULL);
 
+    if (releaseDeferred)
+        settleRelease();
+
     // add the port where the failed packet originated to the front of
     // the waiting ports for the layer, this allows us to call retry
     // on the port immediately if the crossbar layer is idle
@@ -327,6 +382,57 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
     }
 }
 
+void
+BaseXBar::pushRoute(PacketPtr pkt, PortID cpu_side_port_id)
+{
+    RouteSenderState *state;
+    if (freeRouteStates.empty()) {
+        state = new RouteSenderState;
+    } else {
+        state = freeRouteStates.back();
+        freeRouteStates.pop_back();
+    }
+    state->portId = cpu_side_port_id;
+    pkt->pushSenderState(state);
+}
+
+void
+BaseXBar::popRoute(PacketPtr pkt)
+{
+    freeRouteStates.push_back(
+        safe_cast<RouteSenderState *>(pkt->popSenderState()));
+}
+
+void
+BaseXBar::buildDecodeTable()
+{
+    decodeEntries.clear();
+    decodeSpans.clear();
+
+    for (const auto& r: portMap)
+        decodeEntries.push_back({r.first, r.second});
+
+    // order by start so that overlapping ranges, e.g., an interleaved
+    // set, end up next to each other
+    std::sort(decodeEntries.begin(), decodeEntries.end(),
+              [](const DecodeEntry &a, const DecodeEntry &b)
+              { return a.range.start() < b.range.start(); });
+
+    for (uint32_t i = 0; i < decodeEntries.size(); ++i) {
+        const AddrRange &r = decodeEntries[i].range;
+        if (!decodeSpans.empty() && r.start() < decodeSpans.back().end) {
+            decodeSpans.back().end = std::max(decodeSpans.back().end,
+                                              r.end());
+            ++decodeSpans.back().count;
+        } else {
+            decodeSpans.push_back({r.start(), r.end(), i, 1});
+        }
+    }
+
+    DPRINTF(AddrRanges, "Decode table has %d spans for %d ranges\n",
+            decodeSpans.size(), decodeEntries.size());
+}
+
 PortID
 BaseXBar::findPort(AddrRange addr_range)
 {
@@ -334,10 +440,18 @@ BaseXBar::findPort(AddrRange addr_range)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
-    // Check the address map interval tree
-    auto i = portMap.contains(addr_range);
-    if (i != portMap.end()) {
-        return i->second;
+    // Find the last span starting at or before the address and check
+    // the ranges in it
+    const Addr addr = addr_range.start();
+    auto span = std::upper_bound(decodeSpans.begin(), decodeSpans.end(),
+                                 addr, [](Addr a, const DecodeSpan &s)
+                                 { return a < s.start; });
+    if (span != decodeSpans.begin() && addr < (--span)->end) {
+        for (uint32_t i = span->first; i < span->first + span->count; ++i) {
+            const DecodeEntry &entry = decodeEntries[i];
+            if (addr_range.isSubset(entry.range))
+                return entry.portId;
+        }
     }
 
     // Check if this matches the default range
@@ -433,6 +547,8 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
         }
     }
 
+    buildDecodeTable();
+
     // if we have received ranges from all our neighbouring CPU-side-port
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
@@ -590,6 +706,9 @@ BaseXBar::Layer<SrcType, DstType>::drain()
     //We should check that we're not "doing" anything, and that noone is
     //waiting. We might be idle but have someone waiting if the device we
     //contacted for a retry didn't actually retry.
+    if (releaseDeferred)
+        settleRelease();
+
     if (state != IDLE) {
         DPRINTF(Drain, "Crossbar not drained\n");
         return DrainState::Draining;
@@ -47,9 +47,10 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
-#include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
+#include "base/cast.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
 #include "params/BaseXBar.hh"
@@ -224,6 +225,24 @@ class BaseXBar : public ClockedObject
         void releaseLayer();
         EventFunctionWrapper releaseEvent;
 
+        /**
+         * When no port is waiting for the layer, occupying it does
+         * not schedule the release event. The layer stays busy until
+         * busyUntil, and is released on the next access after that
+         * time. The release event is only scheduled if a port has to
+         * wait for the layer, or the layer is asked to drain, before
+         * the occupancy is over.
+         */
+        bool releaseDeferred;
+        Tick busyUntil;
+
+        /**
+         * Settle a deferred release, either by releasing the layer
+         * straight away if the occupancy is over, or by scheduling
+         * the release event.
+         */
+        void settleRelease();
+
         /**
          * Stats for occupancy and utilization. These stats capture
          * the time the layer spends in the busy state and are thus only
@@ -232,6 +251,10 @@ class BaseXBar : public ClockedObject
         statistics::Scalar occupancy;
         statistics::Formula utilization;
 
+        /** Occupancies that did and did not defer the release. */
+        statistics::Scalar deferredReleases;
+        statistics::Scalar scheduledReleases;
+
     };
 
     class ReqLayer : public Layer<ResponsePort, RequestPort>
@@ -316,15 +339,91 @@ class BaseXBar : public ClockedObject
     /** the width of the xbar in bytes */
     const uint32_t width;
 
-    AddrRangeMap<PortID, 3> portMap;
+    /**
+     * The ranges of all memory-side ports, used to detect conflicts
+     * and to aggregate the ranges of the crossbar. Packets are decoded
+     * using the flat decode table built from it.
+     */
+    AddrRangeMap<PortID> portMap;
+
+    /**
+     * An entry of the decode table, i.e., a range of a memory-side
+     * port. Entries whose ranges overlap, as is the case for the
+     * ranges of an interleaved set, are grouped in a span that covers
+     * all of them.
+     */
+    struct DecodeEntry
+    {
+        AddrRange range;
+        PortID portId;
+    };
+
+    /** A contiguous part of the address space and its entries. */
+    struct DecodeSpan
+    {
+        Addr start;
+        Addr end;
+        /** Index of the first entry of the span in decodeEntries */
+        uint32_t first;
+        /** Number of entries in the span */
+        uint32_t count;
+    };
+
+    /**
+     * The decode table, rebuilt on every range change. The spans are
+     * sorted and disjoint, so a lookup is a binary search on the
+     * spans followed by a check of the few entries in the span.
+     */
+    std::vector<DecodeSpan> decodeSpans;
+    std::vector<DecodeEntry> decodeEntries;
+
+    /** Rebuild the decode table from the port map. */
+    void buildDecodeTable();
+
+    /**
+     * Sender state remembering the CPU-side port a request came from
+     * so that the response can be routed back to it. This relies on
+     * the response being the request packet turned around.
+     */
+    class RouteSenderState : public Packet::SenderState
+    {
+      public:
+        PortID portId = InvalidPortID;
+    };
+
+    /** Sender states of responses already routed, for reuse. */
+    std::vector<RouteSenderState*> freeRouteStates;
 
     /**
-     * Remember where request packets came from so that we can route
-     * responses to the appropriate port. This relies on the fact that
-     * the underlying Request pointer inside the Packet stays
-     * constant.
+     * Remember the CPU-side port of a request by pushing a route on
+     * its sender state stack. This is done before the packet is
+     * forwarded, as components further on push their own state.
+     *
+     * @param pkt The request
+     * @param cpu_side_port_id The port the request came from
+     */
+    void pushRoute(PacketPtr pkt, PortID cpu_side_port_id);
+
+    /**
+     * Get the CPU-side port to route a response to, without popping
+     * the route off the stack, e.g., in case the layer is busy.
+     *
+     * @param pkt The response
+     * @return The port the request came from
+     */
+    PortID
+    peekRoute(PacketPtr pkt) const
+    {
+        return safe_cast<RouteSenderState *>(pkt->senderState)->portId;
+    }
+
+    /**
+     * Pop the route of a response, or of a request that could not be
+     * forwarded, off its sender state stack.
+     *
+     * @param pkt The packet
      */
-    std::unordered_map<RequestPtr, PortID> routeTo;
+    void popRoute(PacketPtr pkt);
 
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
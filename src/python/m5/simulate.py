@@ -167,6 +167,26 @@ def instantiate(ckpt_dir=None):
 
 need_startup = True
 
+# Must match SamplingController::SwitchCause in cpu/sampling_controller.cc
+_sampling_switch_cause = "sampling controller switching cpus"
+_sampling_controllers = []
+
+
+def _switchSampledCpus():
+    """Switch the CPUs of the sampling controllers that asked for it.
+    Returns False if no controller did, i.e., the exit was not meant
+    for us."""
+    pending = [c for c in _sampling_controllers if c.switchPending()]
+    for ctrl in pending:
+        old, new = ctrl.warm_cpus, ctrl.detailed_cpus
+        if not ctrl.switchToDetailed():
+            old, new = new, old
+        switchCpus(ctrl.system, list(zip(old, new)), verbose=False)
+        for mem_ctrl in ctrl.mem_ctrls:
+            mem_ctrl.setStatModel(not ctrl.switchToDetailed())
+        ctrl.switched()
+    return bool(pending)
+
 
 def simulate(*args, **kwargs):
     global need_startup
@@ -191,18 +211,38 @@ def simulate(*args, **kwargs):
         # Reset to put the stats in a consistent state.
         stats.reset()
 
-    if _drain_manager.isDrained():
-        _drain_manager.resume()
-
-    # We flush stdout and stderr before and after the simulation to ensure the
-    # output arrive in order.
-    sys.stdout.flush()
-    sys.stderr.flush()
-    sim_out = _m5.event.simulate(*args, **kwargs)
-    sys.stdout.flush()
-    sys.stderr.flush()
+        if hasattr(objects, "SamplingController"):
+            _sampling_controllers.extend(
+                obj
+                for obj in root.descendants()
+                if isinstance(obj, objects.SamplingController)
+            )
 
-    return sim_out
+    # Sampling controllers may exit many times to have their CPUs
+    # switched, which should not cut the requested simulation short.
+    ticks = args[0] if args else kwargs.pop("ticks", None)
+    end_tick = None if ticks is None else curTick() + ticks
+
+    while True:
+        if _drain_manager.isDrained():
+            _drain_manager.resume()
+
+        # We flush stdout and stderr before and after the simulation to
+        # ensure the output arrive in order.
+        sys.stdout.flush()
+        sys.stderr.flush()
+        if end_tick is None:
+            sim_out = _m5.event.simulate()
+        else:
+            sim_out = _m5.event.simulate(max(end_tick - curTick(), 0))
+        sys.stdout.flush()
+        sys.stderr.flush()
+
+        if (
+            sim_out.getCause() != _sampling_switch_cause
+            or not _switchSampledCpus()
+        ):
+            return sim_out
 
 
 def setMaxTick(tick: int) -> None:
@@ -50,6 +50,10 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class BackstoreHugePages(ScopedEnum):
+    vals = ["none", "madvise", "hugetlb"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -105,6 +109,30 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Large backing stores are costly to access through 4KiB host
+    # pages, and a multi-threaded simulation benefits from keeping
+    # each store close to the thread simulating it. Explicit huge
+    # pages must be reserved on the host beforehand, e.g., through
+    # /proc/sys/vm/nr_hugepages.
+    backstore_huge_pages = Param.BackstoreHugePages(
+        "none",
+        "Back the memories with transparent huge pages (madvise) or "
+        "with explicit huge pages (hugetlb), falling back to regular "
+        "pages when not possible",
+    )
+    backstore_prefault_threads = Param.Unsigned(
+        0,
+        "Number of host threads touching the backing store at startup "
+        "so that no page faults are taken during simulation, 0 to "
+        "fault the pages in on demand",
+    )
+    backstore_numa_nodes = VectorParam.Int(
+        [],
+        "Host NUMA node to bind the backing store of the memories "
+        "simulated by each event queue to, indexed by event queue, "
+        "a negative node leaves the store unbound",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script dumps the snapshots written by a MemHeatmapProbe to
+# ASCII format. A snapshot file starts with the magic "gem5hmap", a
+# version and the tick frequency. Every snapshot then has:
+#
+#   start tick, end tick, region size, accesses,
+#   epoch length, number of epochs E,
+#   E bytes read, E bytes written,
+#   number of hot regions H,
+#   H region addresses, H estimated access counts
+#
+# all as 64-bit little-endian integers, with the regions from the
+# hottest to the coldest.
+
+import struct
+import sys
+
+
+def read_u64(f, count=1):
+    data = f.read(8 * count)
+    if len(data) != 8 * count:
+        raise EOFError
+    return struct.unpack("<%dQ" % count, data)
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <heatmap input> <ASCII output>")
+        exit(-1)
+
+    heatmap_in = open(sys.argv[1], "rb")
+    ascii_out = open(sys.argv[2], "w")
+
+    if heatmap_in.read(8) != b"gem5hmap":
+        print("Unrecognized file", sys.argv[1])
+        exit(-1)
+
+    version, tick_freq = read_u64(heatmap_in, 2)
+    if version != 1:
+        print("Unsupported version", version)
+        exit(-1)
+
+    num_snapshots = 0
+    while True:
+        try:
+            start, end, region_size, accesses = read_u64(heatmap_in, 4)
+        except EOFError:
+            break
+        epoch_len, num_epochs = read_u64(heatmap_in, 2)
+        rd_bytes = read_u64(heatmap_in, num_epochs)
+        wr_bytes = read_u64(heatmap_in, num_epochs)
+        (num_hot,) = read_u64(heatmap_in)
+        addrs = read_u64(heatmap_in, num_hot)
+        counts = read_u64(heatmap_in, num_hot)
+
+        ascii_out.write(
+            f"snapshot {num_snapshots}: ticks {start}-{end}, "
+            f"{accesses} accesses, {region_size} byte regions\n"
+        )
+        epoch_s = epoch_len / tick_freq
+        ascii_out.write("epoch_start,read_GBps,write_GBps\n")
+        for i in range(num_epochs):
+            ascii_out.write(
+                f"{start + i * epoch_len},"
+                f"{rd_bytes[i] / epoch_s / 1e9:.3f},"
+                f"{wr_bytes[i] / epoch_s / 1e9:.3f}\n"
+            )
+        ascii_out.write("region,accesses\n")
+        for addr, count in zip(addrs, counts):
+            ascii_out.write(f"{addr:#x},{count}\n")
+        num_snapshots += 1
+
+    print("Parsed snapshots:", num_snapshots)
+
+    ascii_out.close()
+    heatmap_in.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf trace of the instruction dependency graph,
+# as written by the elastic trace probe, to a flat trace that the Trace CPU
+# maps into memory instead of parsing it (see
+# src/cpu/trace/flat_inst_dep_trace.hh for the layout).
+#
+# Usage: flatten_inst_dep_trace.py <protobuf input> <flat output>
+
+import protolib
+import shutil
+import struct
+import sys
+import tempfile
+
+# Import the packet proto definitions. If they are not found, attempt
+# to generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import inst_dep_record_pb2
+except:
+    print("Did not find proto definition, attempting to generate")
+    from subprocess import call
+
+    error = call(
+        [
+            "protoc",
+            "--python_out=util",
+            "--proto_path=src/proto",
+            "src/proto/inst_dep_record.proto",
+        ]
+    )
+    if not error:
+        import inst_dep_record_pb2
+
+        print("Generated proto definitions for instruction dependency record")
+    else:
+        print("Failed to import proto definitions")
+        exit(-1)
+
+MAGIC = b"gem5EDT1"
+RECORDS_OFFSET = 64
+# magic, tick freq, window size, record size, records, deps, deps offset
+HEADER = struct.Struct("<8sQIIQQQ")
+# seq num, phys addr, virt addr, pc, comp delay, dep index, size, flags,
+# weight, order deps, register deps, type
+RECORD = struct.Struct("<6Q3IHBB")
+DEP = struct.Struct("<Q")
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <flat output>")
+        exit(-1)
+
+    # Open the file on read mode
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    try:
+        flat_out = open(sys.argv[2], "wb")
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4)
+
+    if magic_number != b"gem5":
+        print("Unrecognized file")
+        exit(-1)
+
+    header = inst_dep_record_pb2.InstDepRecordHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    print("Tick frequency:", header.tick_freq)
+    print("Window size:", header.window_size)
+
+    # The dependencies go after the records, so buffer them until all the
+    # records are written
+    deps_out = tempfile.TemporaryFile()
+
+    flat_out.write(b"\0" * RECORDS_OFFSET)
+
+    num_packets = 0
+    num_deps = 0
+    packet = inst_dep_record_pb2.InstDepRecord()
+
+    # Decode the packet messages until we hit the end of the file
+    while protolib.decodeMessage(proto_in, packet):
+        if len(packet.rob_dep) > 0xFFFF or len(packet.reg_dep) > 0xFF:
+            print("Seq. num", packet.seq_num, "has too many dependencies")
+            exit(-1)
+
+        flat_out.write(
+            RECORD.pack(
+                packet.seq_num,
+                packet.p_addr,
+                packet.v_addr,
+                packet.pc,
+                packet.comp_delay,
+                num_deps,
+                packet.size,
+                packet.flags,
+                packet.weight,
+                len(packet.rob_dep),
+                len(packet.reg_dep),
+                packet.type,
+            )
+        )
+
+        for dep in list(packet.rob_dep) + list(packet.reg_dep):
+            deps_out.write(DEP.pack(dep))
+        num_deps += len(packet.rob_dep) + len(packet.reg_dep)
+        num_packets += 1
+
+    deps_offset = RECORDS_OFFSET + num_packets * RECORD.size
+    deps_out.seek(0)
+    shutil.copyfileobj(deps_out, flat_out)
+
+    flat_out.seek(0)
+    flat_out.write(
+        HEADER.pack(
+            MAGIC,
+            header.tick_freq,
+            header.window_size,
+            RECORD.size,
+            num_packets,
+            num_deps,
+            deps_offset,
+        )
+    )
+
+    print("Converted", num_packets, "records with", num_deps, "dependencies")
+
+    proto_in.close()
+    flat_out.close()
+
+
+if __name__ == "__main__":
+    main()
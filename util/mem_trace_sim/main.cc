@@ -0,0 +1,681 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ *  Standalone trace-driven simulation of a memory controller. The
+ *  controller and its memory interfaces are instantiated from a
+ *  config.ini, e.g., generated by configs/dram/trace_sim_config.py,
+ *  and a trace of requests is replayed against the controller port
+ *  without any Python or system model on top. Once the trace is
+ *  done, the statistics of the controller and its interfaces, and of
+ *  the replay itself, are written out, including the bandwidth, the
+ *  latency histograms and the power.
+ *
+ *  Build gem5 as a library, see the README.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/cast.hh"
+#include "base/debug.hh"
+#include "base/statistics.hh"
+#include "base/stats/text.hh"
+#include "base/str.hh"
+#include "base/trace.hh"
+#include "config/have_protobuf.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+#include "sim/core.hh"
+#include "sim/cxx_config_ini.hh"
+#include "sim/cxx_manager.hh"
+#include "sim/eventq.hh"
+#include "sim/init_signals.hh"
+#include "sim/sim_events.hh"
+#include "sim/sim_exit.hh"
+#include "sim/simulate.hh"
+#include "sim/stat_control.hh"
+#include "sim/stats.hh"
+#include "sim/system.hh"
+
+#if HAVE_PROTOBUF
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#endif
+
+using namespace gem5;
+
+namespace
+{
+
+/** A request of a trace */
+struct TraceRecord
+{
+    Tick tick;
+    bool isRead;
+    Addr addr;
+    unsigned size;
+};
+
+/**
+ * Parse an unsigned number in any base, unlike to_number() this also
+ * takes hexadecimal numbers with an 'e' in them, e.g., addresses.
+ */
+template <typename T>
+bool
+parseUnsigned(const std::string &value, T &retval)
+{
+    char *end;
+    errno = 0;
+    retval = std::strtoull(value.c_str(), &end, 0);
+    return !value.empty() && *end == '\0' && !errno;
+}
+
+class TraceReader
+{
+  public:
+    virtual ~TraceReader() {}
+
+    /** Read the next request, returns false at the end of the trace */
+    virtual bool next(TraceRecord &record) = 0;
+};
+
+/**
+ * The ASCII packet trace format of util/encode_packet_trace.py, one
+ * request per line as cmd,addr,size,tick, e.g., r,128,64,4000.
+ */
+class TextTraceReader : public TraceReader
+{
+  public:
+    TextTraceReader(const std::string &filename) : trace(filename)
+    {
+        if (!trace)
+            fatal("Can't open trace file: %s\n", filename);
+    }
+
+    bool
+    next(TraceRecord &record) override
+    {
+        std::string line;
+        while (std::getline(trace, line)) {
+            std::vector<std::string> fields;
+            tokenize(fields, line, ',');
+            if (fields.empty() || fields[0][0] == '#')
+                continue;
+
+            fatal_if(fields.size() != 4 ||
+                     !parseUnsigned(fields[1], record.addr) ||
+                     !parseUnsigned(fields[2], record.size) ||
+                     !parseUnsigned(fields[3], record.tick),
+                     "Malformed trace line: %s\n", line);
+            record.isRead = fields[0] == "r";
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    std::ifstream trace;
+};
+
+/**
+ * DRAMSim-style traces, one request per line as address, command and
+ * memory cycle, e.g., 0x7f64768732d0 P_MEM_WR 42 or 0x4ae0a000 READ 7.
+ */
+class DRAMSimTraceReader : public TraceReader
+{
+  public:
+    DRAMSimTraceReader(const std::string &filename, Tick cycle_period,
+                       unsigned size) :
+        trace(filename), cyclePeriod(cycle_period), size(size)
+    {
+        if (!trace)
+            fatal("Can't open trace file: %s\n", filename);
+    }
+
+    bool
+    next(TraceRecord &record) override
+    {
+        std::string line;
+        while (std::getline(trace, line)) {
+            std::vector<std::string> fields;
+            tokenize(fields, line, ' ');
+            if (fields.empty() || fields[0][0] == '#')
+                continue;
+
+            Tick cycle;
+            fatal_if(fields.size() < 3 ||
+                     !parseUnsigned(fields[0], record.addr) ||
+                     !parseUnsigned(fields[2], cycle),
+                     "Malformed trace line: %s\n", line);
+
+            const std::string &cmd = fields[1];
+            record.isRead = cmd.find("RD") != std::string::npos ||
+                cmd.find("READ") != std::string::npos ||
+                cmd == "IFETCH";
+            fatal_if(!record.isRead && cmd.find("WR") == std::string::npos,
+                     "Unknown command in trace line: %s\n", line);
+            record.tick = cycle * cyclePeriod;
+            record.size = size;
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    std::ifstream trace;
+    const Tick cyclePeriod;
+    const unsigned size;
+};
+
+#if HAVE_PROTOBUF
+/** Packet traces as written by MemTraceProbe or CommMonitor */
+class ProtoTraceReader : public TraceReader
+{
+  public:
+    ProtoTraceReader(const std::string &filename) : trace(filename)
+    {
+        ProtoMessage::PacketHeader header;
+        if (!trace.read(header))
+            fatal("Failed to read packet header from %s\n", filename);
+        fatal_if(header.tick_freq() != sim_clock::Frequency,
+                 "Trace was recorded with a different tick frequency %d\n",
+                 header.tick_freq());
+    }
+
+    bool
+    next(TraceRecord &record) override
+    {
+        ProtoMessage::Packet pkt;
+        while (trace.read(pkt)) {
+            const MemCmd cmd(pkt.cmd());
+            if (!cmd.isRead() && !cmd.isWrite())
+                continue;
+            record.tick = pkt.tick();
+            record.isRead = cmd.isRead();
+            record.addr = pkt.addr();
+            record.size = pkt.size();
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    ProtoInputStream trace;
+};
+#endif
+
+/**
+ * Replays a trace against a response port, issuing every request at
+ * its tick or as soon as the controller accepts it, and records the
+ * latency of every request until its response.
+ */
+class TracePlayer : public RequestPort
+{
+  public:
+    TracePlayer(TraceReader &_reader, RequestorID _requestor_id,
+                bool _timed, unsigned _max_outstanding) :
+        RequestPort("trace_player"), reader(_reader),
+        requestorId(_requestor_id), timed(_timed),
+        maxOutstanding(_max_outstanding),
+        sendEvent([this]{ sendNext(); }, "trace_player.sendEvent"),
+        stats()
+    {}
+
+    void
+    start()
+    {
+        traceDone = !reader.next(record);
+        if (traceDone) {
+            exitSimLoop("trace replay complete");
+        } else {
+            curEventQueue()->schedule(&sendEvent, nextSendTick());
+        }
+    }
+
+    struct PlayerStats : public statistics::Group
+    {
+        PlayerStats();
+
+        statistics::Scalar readReqs;
+        statistics::Scalar writeReqs;
+        statistics::Scalar bytesRead;
+        statistics::Scalar bytesWritten;
+        statistics::Formula bandwidth;
+        statistics::Scalar totReadLatency;
+        statistics::Formula avgReadLatency;
+        statistics::Histogram readLatency;
+        statistics::Histogram writeLatency;
+    } stats;
+
+  protected:
+    bool recvTimingResp(PacketPtr pkt) override;
+    void recvReqRetry() override;
+    void recvRangeChange() override {}
+
+  private:
+    /** Remembers when a request was issued */
+    struct IssueState : public Packet::SenderState
+    {
+        IssueState(Tick _issued) : issued(_issued) {}
+        const Tick issued;
+    };
+
+    Tick
+    nextSendTick() const
+    {
+        return timed ? std::max(record.tick, curTick()) : curTick();
+    }
+
+    void sendNext();
+
+    /** Move on to the next request of the trace */
+    void advance();
+
+    TraceReader &reader;
+    const RequestorID requestorId;
+    const bool timed;
+    const unsigned maxOutstanding;
+
+    TraceRecord record;
+    bool traceDone = false;
+
+    /** A request that was not accepted, waiting for a retry */
+    PacketPtr retryPkt = nullptr;
+    unsigned outstanding = 0;
+
+    EventFunctionWrapper sendEvent;
+};
+
+TracePlayer::PlayerStats::PlayerStats()
+    : statistics::Group(nullptr),
+      ADD_STAT(readReqs, statistics::units::Count::get(),
+               "Number of read requests"),
+      ADD_STAT(writeReqs, statistics::units::Count::get(),
+               "Number of write requests"),
+      ADD_STAT(bytesRead, statistics::units::Byte::get(),
+               "Number of bytes read"),
+      ADD_STAT(bytesWritten, statistics::units::Byte::get(),
+               "Number of bytes written"),
+      ADD_STAT(bandwidth, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Achieved bandwidth", (bytesRead + bytesWritten) / simSeconds),
+      ADD_STAT(totReadLatency, statistics::units::Tick::get(),
+               "Total read latency"),
+      ADD_STAT(avgReadLatency, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average read latency", totReadLatency / readReqs),
+      ADD_STAT(readLatency, statistics::units::Tick::get(),
+               "Read latency, from issue to response"),
+      ADD_STAT(writeLatency, statistics::units::Tick::get(),
+               "Write latency, from issue to response")
+{
+    bandwidth.precision(0);
+    avgReadLatency.precision(2);
+    readLatency.init(32).flags(statistics::nozero);
+    writeLatency.init(32).flags(statistics::nozero);
+}
+
+void
+TracePlayer::sendNext()
+{
+    assert(!retryPkt);
+
+    RequestPtr req = std::make_shared<Request>(record.addr, record.size, 0,
+                                               requestorId);
+    PacketPtr pkt = new Packet(req, record.isRead ? MemCmd::ReadReq :
+                                                    MemCmd::WriteReq);
+    pkt->allocate();
+    pkt->pushSenderState(new IssueState(curTick()));
+
+    if (sendTimingReq(pkt)) {
+        advance();
+    } else {
+        retryPkt = pkt;
+    }
+}
+
+void
+TracePlayer::recvReqRetry()
+{
+    assert(retryPkt);
+    PacketPtr pkt = retryPkt;
+    retryPkt = nullptr;
+
+    if (sendTimingReq(pkt)) {
+        advance();
+    } else {
+        retryPkt = pkt;
+    }
+}
+
+void
+TracePlayer::advance()
+{
+    ++outstanding;
+    if (record.isRead) {
+        stats.readReqs++;
+        stats.bytesRead += record.size;
+    } else {
+        stats.writeReqs++;
+        stats.bytesWritten += record.size;
+    }
+
+    traceDone = !reader.next(record);
+    if (!traceDone && (!maxOutstanding || outstanding < maxOutstanding))
+        curEventQueue()->schedule(&sendEvent, nextSendTick());
+}
+
+bool
+TracePlayer::recvTimingResp(PacketPtr pkt)
+{
+    auto *state = safe_cast<IssueState *>(pkt->popSenderState());
+    const Tick latency = curTick() - state->issued;
+    if (pkt->isRead()) {
+        stats.readLatency.sample(latency);
+        stats.totReadLatency += latency;
+    } else {
+        stats.writeLatency.sample(latency);
+    }
+    delete state;
+    delete pkt;
+
+    --outstanding;
+    if (traceDone) {
+        if (!outstanding)
+            exitSimLoop("trace replay complete");
+    } else if (!sendEvent.scheduled() && !retryPkt) {
+        // the player stopped at the outstanding limit
+        curEventQueue()->schedule(&sendEvent, nextSendTick());
+    }
+
+    return true;
+}
+
+void
+forEachGroup(statistics::Group &group,
+             const std::function<void(statistics::Info &)> &func)
+{
+    for (auto *info : group.getStats())
+        func(*info);
+    for (auto &child : group.getStatGroups())
+        forEachGroup(*child.second, func);
+}
+
+void
+dumpGroup(statistics::Output &output, statistics::Group &group)
+{
+    for (auto *info : group.getStats()) {
+        info->prepare();
+        info->visit(output);
+    }
+    for (auto &child : group.getStatGroups()) {
+        output.beginGroup(child.first.c_str());
+        dumpGroup(output, *child.second);
+        output.endGroup();
+    }
+}
+
+void
+usage(const std::string &prog_name)
+{
+    std::cerr << "Usage: " << prog_name << (
+        " <config-file.ini> <trace> [ <option> ]\n\n"
+        "OPTIONS:\n"
+        "    -f <format>     -- trace format: text (default), dramsim or\n"
+        "                       proto\n"
+        "    -c <object>     -- memory controller to replay the trace on\n"
+        "                       (default system.mem_ctrl)\n"
+        "    -o <file>       -- statistics output (default stats.txt)\n"
+        "    -k <ticks>      -- cycle period of dramsim traces (default\n"
+        "                       1000)\n"
+        "    -s <bytes>      -- request size of dramsim traces (default\n"
+        "                       64)\n"
+        "    -u              -- untimed, issue requests as fast as the\n"
+        "                       controller accepts them\n"
+        "    -m <requests>   -- maximum outstanding requests (default\n"
+        "                       unlimited)\n"
+        "    -p <object> <param> <value>  -- set a parameter\n"
+        "    -d <flag>       -- set a debug flag (-<flag> clear a flag)\n"
+        "\n"
+        );
+
+    std::exit(EXIT_FAILURE);
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    std::string prog_name(argv[0]);
+
+    if (argc < 3)
+        usage(prog_name);
+
+    initSignals();
+
+    setClockFrequency(1000000000000);
+    fixClockFrequency();
+    curEventQueue(getEventQueue(0));
+
+    statistics::initSimStats();
+
+    trace::enable();
+
+    const std::string config_file(argv[1]);
+    const std::string trace_file(argv[2]);
+
+    std::string format = "text";
+    std::string ctrl_name = "system.mem_ctrl";
+    std::string stats_file = "stats.txt";
+    Tick cycle_period = 1000;
+    unsigned dramsim_size = 64;
+    bool timed = true;
+    unsigned max_outstanding = 0;
+
+    CxxConfigFileBase *conf = new CxxIniFile();
+
+    if (!conf->load(config_file.c_str())) {
+        std::cerr << "Can't open config file: " << config_file << '\n';
+        return EXIT_FAILURE;
+    }
+
+    CxxConfigManager *config_manager = new CxxConfigManager(*conf);
+
+    try {
+        for (int arg_ptr = 3; arg_ptr < argc; ) {
+            std::string option(argv[arg_ptr]);
+            arg_ptr++;
+            unsigned num_args = argc - arg_ptr;
+
+            if (option == "-u") {
+                timed = false;
+                continue;
+            }
+
+            if (num_args < 1)
+                usage(prog_name);
+
+            if (option == "-f") {
+                format = argv[arg_ptr];
+            } else if (option == "-c") {
+                ctrl_name = argv[arg_ptr];
+            } else if (option == "-o") {
+                stats_file = argv[arg_ptr];
+            } else if (option == "-k") {
+                std::istringstream(argv[arg_ptr]) >> cycle_period;
+            } else if (option == "-s") {
+                std::istringstream(argv[arg_ptr]) >> dramsim_size;
+            } else if (option == "-m") {
+                std::istringstream(argv[arg_ptr]) >> max_outstanding;
+            } else if (option == "-d") {
+                if (argv[arg_ptr][0] == '-')
+                    clearDebugFlag(argv[arg_ptr] + 1);
+                else
+                    setDebugFlag(argv[arg_ptr]);
+            } else if (option == "-p") {
+                if (num_args < 3)
+                    usage(prog_name);
+                config_manager->setParam(argv[arg_ptr], argv[arg_ptr + 1],
+                    argv[arg_ptr + 2]);
+                arg_ptr += 2;
+            } else {
+                usage(prog_name);
+            }
+            arg_ptr++;
+        }
+    } catch (CxxConfigManager::Exception &e) {
+        std::cerr << e.name << ": " << e.message << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<TraceReader> reader;
+    if (format == "text") {
+        reader.reset(new TextTraceReader(trace_file));
+    } else if (format == "dramsim") {
+        reader.reset(new DRAMSimTraceReader(trace_file, cycle_period,
+                                            dramsim_size));
+    } else if (format == "proto") {
+#if HAVE_PROTOBUF
+        reader.reset(new ProtoTraceReader(trace_file));
+#else
+        std::cerr << "Protobuf traces need gem5 built with protobuf\n";
+        return EXIT_FAILURE;
+#endif
+    } else {
+        usage(prog_name);
+    }
+
+    // the statistics are dumped for the controller and everything
+    // below it, e.g., its memory interfaces
+    std::vector<std::string> dump_objects;
+    std::vector<SimObject *> dump_groups;
+    std::unique_ptr<TracePlayer> player;
+
+    try {
+        config_manager->findAllObjects();
+        for (auto *object : config_manager->objectsInOrder)
+            config_manager->bindObjectPorts(object);
+
+        SimObject &ctrl = config_manager->getObject<SimObject>(ctrl_name);
+
+        // the requestor must be known before the controller sizes its
+        // per-requestor statistics
+        System *system = nullptr;
+        std::string system_name;
+        if (conf->getParam(ctrl_name, "system", system_name))
+            system = &config_manager->getObject<System>(system_name);
+        fatal_if(!system, "%s has no system\n", ctrl_name);
+        player.reset(new TracePlayer(*reader,
+            system->getGlobalRequestorId("trace_player"), timed,
+            max_outstanding));
+        player->bind(ctrl.getPort("port"));
+
+        dump_objects.push_back(ctrl_name);
+        for (size_t i = 0; i < dump_objects.size(); ++i) {
+            std::vector<std::string> children;
+            conf->getObjectChildren(dump_objects[i], children, true);
+            dump_objects.insert(dump_objects.end(), children.begin(),
+                                children.end());
+        }
+        for (const auto &name : dump_objects)
+            dump_groups.push_back(&config_manager->getObject<SimObject>(name));
+
+        config_manager->instantiate(false);
+        config_manager->initState();
+        config_manager->startup();
+    } catch (CxxConfigManager::Exception &e) {
+        std::cerr << "Config problem in sim object " << e.name
+            << ": " << e.message << "\n";
+
+        return EXIT_FAILURE;
+    }
+
+    for (auto *info : statistics::statsList())
+        info->enable();
+    auto enable = [](statistics::Info &info) { info.enable(); };
+    forEachGroup(player->stats, enable);
+    for (auto *group : dump_groups)
+        forEachGroup(*group, enable);
+
+    player->start();
+    GlobalSimLoopExitEvent *exit_event = simulate();
+
+    std::cerr << "Exit at tick " << curTick()
+        << ", cause: " << exit_event->getCause() << '\n';
+
+    // let the controller catch up and the interfaces compute their
+    // power before anything is written out
+    for (auto *group : dump_groups)
+        group->preDumpStats();
+
+    statistics::Output *output = statistics::initText(stats_file, true,
+                                                      true);
+    output->begin();
+    for (auto *info : statistics::statsList()) {
+        info->prepare();
+        info->visit(*output);
+    }
+    output->beginGroup("trace_player");
+    dumpGroup(*output, player->stats);
+    output->endGroup();
+    for (size_t i = 0; i < dump_groups.size(); ++i) {
+        output->beginGroup(dump_objects[i].c_str());
+        dumpGroup(*output, *dump_groups[i]);
+        output->endGroup();
+    }
+    output->end();
+
+    double average_power = 0;
+    for (auto *group : dump_groups) {
+        forEachGroup(*group, [&](statistics::Info &info) {
+            auto *scalar = dynamic_cast<statistics::ScalarInfo *>(&info);
+            if (scalar && info.name == "averagePower")
+                average_power += scalar->value();
+        });
+    }
+
+    std::cout << "Requests: " << player->stats.readReqs.value() << " reads, "
+        << player->stats.writeReqs.value() << " writes\n"
+        << "Bandwidth: " << player->stats.bandwidth.total() / 1e9
+        << " GB/s\n"
+        << "Read latency: "
+        << player->stats.avgReadLatency.total() << " ticks\n"
+        << "Average power: " << average_power << " mW\n";
+
+    return EXIT_SUCCESS;
+}